@@ -1,14 +1,34 @@
 #include "heap.hpp"
 
-void Heap::InsertKey(long long elem) {
-  if (query_to_index_map_.size() <= inserted_id_) {
-    query_to_index_map_.resize(inserted_id_ + 1, -1);
+size_t Heap::AcquireSlot() {
+  if (free_slots_.empty()) {
+    query_to_index_map_.push_back(-1);
+    generations_.push_back(0);
+    return query_to_index_map_.size() - 1;
   }
-  heap_array_.emplace_back(elem, inserted_id_);
+  size_t slot = free_slots_.back();
+  free_slots_.pop_back();
+  return slot;
+}
+
+void Heap::ReleaseSlot(size_t slot) {
+  query_to_index_map_[slot] = -1;
+  // A generation that would wrap around retires the slot instead, otherwise a
+  // handle from 2^32 reuses ago would match again
+  if (generations_[slot] == UINT32_MAX) {
+    return;
+  }
+  ++generations_[slot];
+  free_slots_.push_back(slot);
+}
+
+size_t Heap::InsertKey(long long elem) {
+  size_t slot = AcquireSlot();
+  heap_array_.emplace_back(elem, slot);
   size_t curr_elem_idx = LastElem();
-  query_to_index_map_[inserted_id_] = curr_elem_idx;
+  query_to_index_map_[slot] = curr_elem_idx;
   SiftUp(curr_elem_idx);
-  ++inserted_id_;
+  return slot | (static_cast<size_t>(generations_[slot]) << cSlotBits);
 }
 
 void Heap::SiftUp(size_t vertex_idx) {
@@ -49,7 +69,7 @@ void Heap::SiftDown(size_t curr_idx) {
 
 void Heap::ExtractMin() {
   query_to_index_map_[heap_array_[LastElem()].second] = 0;
-  query_to_index_map_[heap_array_[0].second] = -1;
+  ReleaseSlot(heap_array_[0].second);
   std::swap(heap_array_[0], heap_array_[LastElem()]);
   heap_array_.pop_back();
   if (!heap_array_.empty()) {
@@ -57,10 +77,12 @@ void Heap::ExtractMin() {
   }
 }
 
-void Heap::DecreaseKey(size_t inserted_id_, long long val) {
-  if (inserted_id_ < query_to_index_map_.size() &&
-      query_to_index_map_[inserted_id_] != static_cast<size_t>(-1)) {
-    size_t idx = query_to_index_map_[inserted_id_];
+void Heap::DecreaseKey(size_t handle, long long val) {
+  size_t slot = handle & cSlotMask;
+  size_t generation = handle >> cSlotBits;
+  if (slot < query_to_index_map_.size() && generations_[slot] == generation &&
+      query_to_index_map_[slot] != static_cast<size_t>(-1)) {
+    size_t idx = query_to_index_map_[slot];
     heap_array_[idx].first -= val;
     SiftUp(idx);
   }
@@ -7,26 +7,43 @@ children
 except possibly the last, which is filled from left to right.
 
 It supports inserting new values, extracting the smallest element and decreasing
-the value of an element by its insertion order index in O(logn) time.
+the value of an element by the handle returned on its insertion in O(logn) time.
+
+Handles are recycled: an extracted element's slot goes to a free list and is
+reused by the next insertion, so memory stays proportional to the peak number
+of live elements rather than to the total number of insertions. Each slot
+keeps a generation counter which is embedded into the handle, so a handle of
+an already extracted element is recognized as stale and ignored. A slot whose
+32-bit generation is exhausted is never reused again, so generations do not
+wrap around and stale handles stay stale. Until the first extraction handles
+coincide with insertion order indices.
 */
 
 #include <algorithm>
+#include <climits>
 #include <cstdint>
 #include <vector>
 
 class Heap {
  public:
-  void InsertKey(long long elem);
+  size_t InsertKey(long long elem);
   void SiftUp(size_t idx);
   void SiftDown(size_t idx);
   void ExtractMin();
-  void DecreaseKey(size_t query_num, long long val);
+  void DecreaseKey(size_t handle, long long val);
   long long GetMin() const;
 
  private:
-  size_t inserted_id_ = 0;
-  std::vector<std::pair<long long, size_t>> heap_array_;
+  static constexpr size_t cSlotBits = 32;
+  static constexpr size_t cSlotMask = (size_t{1} << cSlotBits) - 1;
+
+  std::vector<std::pair<long long, size_t>> heap_array_;  // (value, slot)
   std::vector<size_t> query_to_index_map_;
+  std::vector<uint32_t> generations_;
+  std::vector<size_t> free_slots_;
+
+  size_t AcquireSlot();
+  void ReleaseSlot(size_t slot);
 
   static size_t Parent(size_t idx) { return (idx - 1) / 2; }
   static size_t LeftChild(size_t idx) { return 2 * idx + 1; }
@@ -42,6 +42,39 @@ TEST(HeapTest, DecreaseKeyTest) {
   EXPECT_EQ(h.GetMin(), 10);
 }
 
+TEST(HeapTest, StaleHandleTest) {
+  Heap h;
+  size_t first = h.InsertKey(10);
+  h.ExtractMin();
+
+  size_t second = h.InsertKey(20);
+  EXPECT_NE(first, second);
+
+  h.DecreaseKey(first, 15);  // stale handle, ignored
+  EXPECT_EQ(h.GetMin(), 20);
+
+  h.DecreaseKey(second, 15);  // 20 - 15 = 5
+  EXPECT_EQ(h.GetMin(), 5);
+}
+
+TEST(HeapTest, HandleRecyclingTest) {
+  Heap h;
+  std::vector<size_t> handles;
+  for (size_t i = 0; i < 4; ++i) {
+    handles.push_back(h.InsertKey(100 + i));
+  }
+
+  const size_t cMask = (size_t{1} << 32) - 1;
+  for (size_t i = 0; i < 100'000; ++i) {
+    h.ExtractMin();
+    size_t handle = h.InsertKey(1000 + i);
+    EXPECT_LT(handle & cMask, 4);
+  }
+
+  h.DecreaseKey(handles[3], 100);  // extracted long ago, ignored
+  EXPECT_EQ(h.GetMin(), 100'996);
+}
+
 TEST(HeapTest, StressTest) {
   Heap h;
   const size_t N = 1'000'000;
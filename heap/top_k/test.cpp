@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "top_k.hpp"
+
+TEST(TopKTest, PushTest) {
+  TopK top(3);
+  top.Push(5);
+  top.Push(1);
+  EXPECT_EQ(top.Size(), 2);
+  EXPECT_EQ(top.Threshold(), 1);
+
+  top.Push(10);
+  top.Push(7);
+  top.Push(-4);
+  EXPECT_EQ(top.Size(), 3);
+  EXPECT_EQ(top.Threshold(), 5);
+  EXPECT_EQ(top.GetSorted(), (std::vector<long long>{10, 7, 5}));
+}
+
+TEST(TopKTest, ZeroKTest) {
+  TopK top(0);
+  top.Push(1);
+  top.PushBatch({1, 2, 3});
+  EXPECT_EQ(top.Size(), 0);
+}
+
+TEST(TopKTest, MergeTest) {
+  TopK first(2);
+  TopK second(2);
+  first.PushBatch({1, 8, 3});
+  second.PushBatch({9, 2, 4});
+  first.Merge(second);
+  EXPECT_EQ(first.GetSorted(), (std::vector<long long>{9, 8}));
+}
+
+TEST(TopKTest, StressTest) {
+  const size_t N = 1'000'000;
+  const size_t K = 100;
+  const long long cMod = 1'000'000;
+  std::srand(std::time(nullptr));
+
+  std::vector<long long> stream(N);
+  for (size_t i = 0; i < N; ++i) {
+    stream[i] = std::rand() % cMod;
+  }
+
+  TopK batched(K);
+  TopK merged(K);
+  TopK partial(K);
+  batched.PushBatch(stream);
+  for (size_t i = 0; i < N; ++i) {
+    (i % 2 == 0 ? merged : partial).Push(stream[i]);
+  }
+  merged.Merge(partial);
+
+  std::sort(stream.begin(), stream.end(), std::greater<long long>());
+  stream.resize(K);
+  EXPECT_EQ(batched.GetSorted(), stream);
+  EXPECT_EQ(merged.GetSorted(), stream);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
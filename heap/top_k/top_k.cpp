@@ -0,0 +1,90 @@
+#include "top_k.hpp"
+
+TopK::TopK(size_t k) : k_(k), filled_(false) { heap_.reserve(k_); }
+
+void TopK::Push(long long elem) {
+  if (filled_) {
+    if (elem <= heap_[0]) {
+      return;
+    }
+    heap_[0] = elem;
+    SiftDown(0);
+    return;
+  }
+  // Never filled for k = 0, so the path above can always read the root
+  if (k_ == 0) {
+    return;
+  }
+  heap_.push_back(elem);
+  SiftUp(LastElem());
+  filled_ = heap_.size() == k_;
+}
+
+void TopK::PushBatch(const std::vector<long long>& batch) {
+  size_t pos = 0;
+  while (pos < batch.size() && heap_.size() < k_) {
+    Push(batch[pos++]);
+  }
+  if (k_ == 0) {
+    return;
+  }
+
+  while (pos < batch.size()) {
+    size_t chunk_end = std::min(pos + cChunkSize, batch.size());
+    long long threshold = heap_[0];
+    size_t candidates = 0;
+    for (size_t i = pos; i < chunk_end; ++i) {
+      candidates += static_cast<size_t>(batch[i] > threshold);
+    }
+    if (candidates != 0) {
+      for (size_t i = pos; i < chunk_end; ++i) {
+        Push(batch[i]);
+      }
+    }
+    pos = chunk_end;
+  }
+}
+
+void TopK::Merge(const TopK& other) {
+  for (long long elem : other.heap_) {
+    Push(elem);
+  }
+}
+
+std::vector<long long> TopK::GetSorted() const {
+  std::vector<long long> result = heap_;
+  std::sort(result.begin(), result.end(), std::greater<long long>());
+  return result;
+}
+
+void TopK::SiftUp(size_t vertex_idx) {
+  if (vertex_idx == 0) {
+    return;
+  }
+  size_t parent_idx = Parent(vertex_idx);
+  if (heap_[parent_idx] > heap_[vertex_idx]) {
+    std::swap(heap_[parent_idx], heap_[vertex_idx]);
+    SiftUp(parent_idx);
+  }
+}
+
+void TopK::SiftDown(size_t curr_idx) {
+  size_t min_child_idx = curr_idx;
+  size_t left_child_idx = LeftChild(curr_idx);
+  size_t right_child_idx = RightChild(curr_idx);
+
+  if (left_child_idx < heap_.size() &&
+      heap_[left_child_idx] < heap_[min_child_idx]) {
+    min_child_idx = left_child_idx;
+  }
+
+  if (right_child_idx < heap_.size() &&
+      heap_[right_child_idx] < heap_[min_child_idx]) {
+    min_child_idx = right_child_idx;
+  }
+
+  if (min_child_idx != curr_idx) {
+    std::swap(heap_[curr_idx], heap_[min_child_idx]);
+    SiftDown(min_child_idx);
+  }
+}
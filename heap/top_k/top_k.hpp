@@ -0,0 +1,49 @@
+/*
+How it works:
+TopK keeps the K largest elements of a stream in a min-heap of size K. The
+root of the heap is the smallest kept element, i.e. the threshold a new
+candidate has to beat. Once the heap is full, every candidate below the
+threshold is rejected with a single comparison, and every other one replaces
+the root followed by a sift down.
+
+Batches are processed in chunks: a branchless (vectorizable) pass counts the
+elements of a chunk that beat the current threshold, and the whole chunk is
+skipped when there are none, which is the common case for a long stream.
+
+Partial results (e.g. computed by different threads) are combined via Merge.
+
+Time Complexity: O(1) per rejected element, O(logK) per accepted element
+Memory Complexity: O(K)
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class TopK {
+ public:
+  static constexpr size_t cChunkSize = 256;
+
+  TopK(size_t k);
+
+  void Push(long long elem);
+  void PushBatch(const std::vector<long long>& batch);
+  void Merge(const TopK& other);
+  long long Threshold() const { return heap_[0]; }
+  size_t Size() const { return heap_.size(); }
+  std::vector<long long> GetSorted() const;
+
+ private:
+  size_t k_;
+  bool filled_;  // heap_ holds k_ elements, set once and never reset
+  std::vector<long long> heap_;
+
+  void SiftUp(size_t idx);
+  void SiftDown(size_t idx);
+
+  static size_t Parent(size_t idx) { return (idx - 1) / 2; }
+  static size_t LeftChild(size_t idx) { return 2 * idx + 1; }
+  static size_t RightChild(size_t idx) { return 2 * idx + 2; }
+  size_t LastElem() { return heap_.size() - 1; }
+};
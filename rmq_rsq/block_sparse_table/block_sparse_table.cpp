@@ -0,0 +1,64 @@
+#include "block_sparse_table.hpp"
+
+BlockSparseTable::BlockSparseTable(const std::vector<long long>& arr)
+    : arr_(arr),
+      masks_(arr.size()),
+      num_blocks_((arr.size() + cBlockSize - 1) / cBlockSize) {
+  for (size_t start = 0; start < arr_.size(); start += cBlockSize) {
+    uint64_t stack = 0;
+    size_t end = std::min(start + cBlockSize, arr_.size());
+    for (size_t i = start; i < end; ++i) {
+      while (stack != 0 && arr_[start + Log2(stack)] > arr_[i]) {
+        stack ^= uint64_t{1} << Log2(stack);
+      }
+      stack |= uint64_t{1} << (i - start);
+      masks_[i] = stack;
+    }
+  }
+
+  if (num_blocks_ == 0) {
+    return;
+  }
+  size_t num_levels = Log2(num_blocks_) + 1;
+  block_table_.resize(num_levels * num_blocks_);
+  for (size_t b = 0; b < num_blocks_; ++b) {
+    size_t start = b * cBlockSize;
+    size_t end = std::min(start + cBlockSize, arr_.size());
+    block_table_[b] = InBlockMin(start, end - 1);
+  }
+  for (size_t j = 1; j < num_levels; ++j) {
+    const long long* prev = block_table_.data() + (j - 1) * num_blocks_;
+    long long* curr = block_table_.data() + j * num_blocks_;
+    size_t half = size_t{1} << (j - 1);
+    for (size_t b = 0; b + 2 * half <= num_blocks_; ++b) {
+      curr[b] = std::min(prev[b], prev[b + half]);
+    }
+  }
+}
+
+long long BlockSparseTable::MinQuery(long long l, long long r) const {
+  size_t left_block = l / cBlockSize;
+  size_t right_block = r / cBlockSize;
+  if (left_block == right_block) {
+    return InBlockMin(l, r);
+  }
+  long long res =
+      std::min(InBlockMin(l, (left_block + 1) * cBlockSize - 1),
+               InBlockMin(right_block * cBlockSize, r));
+  if (left_block + 1 < right_block) {
+    res = std::min(res, BlockRangeMin(left_block + 1, right_block - 1));
+  }
+  return res;
+}
+
+long long BlockSparseTable::InBlockMin(size_t l, size_t r) const {
+  size_t start = l - l % cBlockSize;
+  uint64_t stack = masks_[r] >> (l - start);
+  return arr_[l + __builtin_ctzll(stack)];
+}
+
+long long BlockSparseTable::BlockRangeMin(size_t l, size_t r) const {
+  size_t j = Log2(r - l + 1);
+  const long long* level = block_table_.data() + j * num_blocks_;
+  return std::min(level[l], level[r - (size_t{1} << j) + 1]);
+}
@@ -0,0 +1,42 @@
+/*
+How it works:
+A regular sparse table answers range minimum queries in O(1) but needs
+O(nlogn) memory. This structure keeps the O(1) query with O(n) memory by
+splitting the array into blocks of 64 elements:
+- A sparse table is built only over the n / 64 block minimums.
+- Inside a block, every position i stores a 64-bit mask of the monotonic
+stack after processing a[block_start...i]: bit k is set if a[block_start + k]
+is smaller than every element after it up to i. For a query [l, r] inside one
+block, the stack at r restricted to positions >= l starts exactly at the
+minimum of a[l...r], so the answer is the lowest set bit of
+mask[r] >> (l - block_start), found with a single count-trailing-zeros.
+
+A query [l, r] that spans several blocks is answered as the minimum of a
+suffix of l's block, a prefix of r's block (both via masks) and the sparse
+table over the whole blocks between them.
+
+Time Complexity: O(n) build + O(1) for each query
+Memory Complexity: O(n), about 16 bytes per element (value and mask)
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class BlockSparseTable {
+ public:
+  BlockSparseTable(const std::vector<long long>& arr);
+  long long MinQuery(long long l, long long r) const;
+
+ private:
+  static constexpr size_t cBlockSize = 64;
+
+  std::vector<long long> arr_;
+  std::vector<uint64_t> masks_;
+  size_t num_blocks_;
+  std::vector<long long> block_table_;  // level-major over block minimums
+
+  long long InBlockMin(size_t l, size_t r) const;
+  long long BlockRangeMin(size_t l, size_t r) const;
+  static size_t Log2(size_t val) { return 63 - __builtin_clzll(val); }
+};
@@ -0,0 +1,34 @@
+#include "block_sparse_table.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(BlockSparseTableTest, Test) {
+  std::vector<long long> arr{-100, 200, 70, -300, 0};
+  BlockSparseTable st(arr);
+  EXPECT_EQ(st.MinQuery(0, 2), -100);
+  EXPECT_EQ(st.MinQuery(1, 4), -300);
+  EXPECT_EQ(st.MinQuery(4, 4), 0);
+}
+
+TEST(BlockSparseTableTest, StressTest) {
+  std::srand(std::time(nullptr));
+  for (size_t n : {1, 63, 64, 65, 200, 1000}) {
+    std::vector<long long> arr(n);
+    for (auto& elem : arr) {
+      elem = std::rand() % 100;  // plenty of duplicates
+    }
+    BlockSparseTable st(arr);
+
+    for (size_t i = 0; i < 5'000; ++i) {
+      size_t l = std::rand() % n;
+      size_t r = l + std::rand() % (n - l);
+      EXPECT_EQ(st.MinQuery(l, r),
+                *std::min_element(arr.begin() + l, arr.begin() + r + 1));
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,50 @@
+#include "concurrent_fenwick_tree.hpp"
+
+void ConcurrentFenwickTree::Update(size_t pos, long long val) {
+  for (size_t i = pos; i < size_; i = (i | (i + 1))) {
+    fenwick_[i].fetch_add(val, std::memory_order_relaxed);
+  }
+}
+
+long long ConcurrentFenwickTree::GetPrefixSum(long long pos) const {
+  long long ans = 0;
+  for (long long i = pos; i >= 0; i = (i & (i + 1)) - 1) {
+    ans += fenwick_[i].load(std::memory_order_relaxed);
+  }
+  return ans;
+}
+
+long long ConcurrentFenwickTree::GetSum(long long left, long long right) const {
+  return GetPrefixSum(right) - GetPrefixSum(left - 1);
+}
+
+ShardedFenwickTree::ShardedFenwickTree(size_t size, size_t num_shards)
+    : size_(size) {
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    shards_.emplace_back(size_);
+  }
+}
+
+void ShardedFenwickTree::Update(size_t shard, size_t pos, long long val) {
+  Shard& owned = shards_[shard];
+  for (size_t i = pos; i < size_; i = (i | (i + 1))) {
+    std::atomic<long long>& cell = owned.Cell(i);
+    cell.store(cell.load(std::memory_order_relaxed) + val,
+               std::memory_order_relaxed);
+  }
+}
+
+long long ShardedFenwickTree::GetPrefixSum(long long pos) const {
+  long long ans = 0;
+  for (const Shard& shard : shards_) {
+    for (long long i = pos; i >= 0; i = (i & (i + 1)) - 1) {
+      ans += shard.Cell(i).load(std::memory_order_relaxed);
+    }
+  }
+  return ans;
+}
+
+long long ShardedFenwickTree::GetSum(long long left, long long right) const {
+  return GetPrefixSum(right) - GetPrefixSum(left - 1);
+}
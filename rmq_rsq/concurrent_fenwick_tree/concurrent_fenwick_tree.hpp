@@ -0,0 +1,81 @@
+/*
+How it works:
+These are Fenwick trees (see rmq_rsq/fenwick_tree) for counters shared by many
+threads, e.g. histogram buckets updated concurrently, without any locks.
+
+ConcurrentFenwickTree stores every cell as an atomic. An update adds its value
+to each touched cell with a relaxed fetch_add, and a prefix query reads the
+cells with relaxed loads. The cells read by a prefix query cover disjoint
+ranges, so every update at a position <= pos is counted by exactly one of them:
+a concurrent query sees each update either entirely or not at all, and sees
+all of them once the writers are done (eventual consistency). GetSum combines
+two prefix queries, so it may mix two different moments in time.
+
+ShardedFenwickTree avoids contention on hot cells altogether: each writer
+thread owns a shard (a separate tree) and is its only writer, so an update is
+a plain relaxed load and store without a locked read-modify-write. The cells
+of a shard are allocated as whole 64-byte aligned cache lines, so no line is
+shared between two shards. A query sums the answers of all shards.
+
+Time Complexity: O(logn) per update, O(logn) (O(S logn) for S shards) per query
+Memory Complexity: O(n) (O(S n) for S shards)
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class ConcurrentFenwickTree {
+ public:
+  explicit ConcurrentFenwickTree(size_t size) : fenwick_(size), size_(size) {}
+
+  void Update(size_t pos, long long val);
+
+  long long GetPrefixSum(long long pos) const;
+
+  long long GetSum(long long left, long long right) const;
+
+ private:
+  std::vector<std::atomic<long long>> fenwick_;
+  size_t size_;
+};
+
+class ShardedFenwickTree {
+ public:
+  ShardedFenwickTree(size_t size, size_t num_shards);
+
+  // Only one thread may update a given shard at a time
+  void Update(size_t shard, size_t pos, long long val);
+
+  long long GetPrefixSum(long long pos) const;
+
+  long long GetSum(long long left, long long right) const;
+
+  size_t ShardCount() const { return shards_.size(); }
+
+ private:
+  static constexpr size_t cCellsPerLine = 8;
+
+  struct alignas(64) CacheLine {
+    std::atomic<long long> cells[cCellsPerLine];
+  };
+
+  struct Shard {
+    // Value-initialization zeroes the cells
+    explicit Shard(size_t size)
+        : lines(new CacheLine[(size + cCellsPerLine - 1) / cCellsPerLine]()) {}
+
+    std::atomic<long long>& Cell(size_t i) {
+      return lines[i / cCellsPerLine].cells[i % cCellsPerLine];
+    }
+    const std::atomic<long long>& Cell(size_t i) const {
+      return lines[i / cCellsPerLine].cells[i % cCellsPerLine];
+    }
+
+    std::unique_ptr<CacheLine[]> lines;
+  };
+
+  std::vector<Shard> shards_;
+  size_t size_;
+};
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "concurrent_fenwick_tree.hpp"
+
+TEST(ConcurrentFenwickTreeTest, GetSumSimpleTest) {
+  ConcurrentFenwickTree tree(5);
+  std::vector<long long> arr{-100, 200, 70, -300, 0};
+  for (size_t i = 0; i < arr.size(); ++i) {
+    tree.Update(i, arr[i]);
+  }
+  EXPECT_EQ(tree.GetPrefixSum(4), -130);
+  EXPECT_EQ(tree.GetSum(2, 4), -230);
+}
+
+TEST(ConcurrentFenwickTreeTest, ConcurrentUpdateTest) {
+  const size_t N = 1'000;
+  const size_t cThreads = 4;
+  const size_t cUpdates = 100'000;
+
+  ConcurrentFenwickTree tree(N);
+  ShardedFenwickTree sharded(N, cThreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < cThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < cUpdates; ++i) {
+        size_t pos = (i * 7 + t) % N;
+        tree.Update(pos, 1);
+        sharded.Update(t, pos, 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(tree.GetPrefixSum(N - 1), cThreads * cUpdates);
+  EXPECT_EQ(sharded.GetPrefixSum(N - 1), cThreads * cUpdates);
+  for (size_t left = 0; left < N; left += 97) {
+    EXPECT_EQ(tree.GetSum(left, N - 1), sharded.GetSum(left, N - 1));
+  }
+  EXPECT_EQ(tree.GetSum(0, 0), cThreads * cUpdates / N);
+}
+
+TEST(ConcurrentFenwickTreeTest, ShardBoundaryTest) {
+  // Sizes that are not multiples of a cache line leave each shard a partial
+  // last line, which must still be zero-initialized
+  for (size_t n : {1, 7, 9, 100}) {
+    ShardedFenwickTree sharded(n, 3);
+    sharded.Update(0, n - 1, 5);
+    sharded.Update(2, n - 1, 2);
+    EXPECT_EQ(sharded.GetPrefixSum(n - 1), 7);
+    EXPECT_EQ(sharded.GetSum(0, n - 1), 7);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
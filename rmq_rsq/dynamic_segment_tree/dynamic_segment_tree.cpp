@@ -0,0 +1,66 @@
+#include "dynamic_segment_tree.hpp"
+
+DynamicSegmentTree::DynamicSegmentTree(size_t reserved_nodes) {
+  pool_.reserve(std::max<size_t>(reserved_nodes, 1));
+  NewNode();
+}
+
+uint32_t DynamicSegmentTree::NewNode() {
+  pool_.emplace_back();
+  return pool_.size() - 1;
+}
+
+void DynamicSegmentTree::Update(uint64_t pos, long long val) {
+  uint32_t path[cMaxDepth];
+  size_t depth = 0;
+  uint32_t node = 0;
+  uint64_t left = 0;
+  uint64_t right = UINT64_MAX;
+
+  while (left != right) {
+    path[depth++] = node;
+    uint64_t mid = left + (right - left) / 2;
+    if (pos <= mid) {
+      if (pool_[node].left == 0) {
+        uint32_t child = NewNode();
+        pool_[node].left = child;
+      }
+      node = pool_[node].left;
+      right = mid;
+    } else {
+      if (pool_[node].right == 0) {
+        uint32_t child = NewNode();
+        pool_[node].right = child;
+      }
+      node = pool_[node].right;
+      left = mid + 1;
+    }
+  }
+  pool_[node].val = val;
+
+  while (depth > 0) {
+    Node& parent = pool_[path[--depth]];
+    parent.val = std::max(ValueOf(parent.left), ValueOf(parent.right));
+  }
+}
+
+long long DynamicSegmentTree::GetMax(uint32_t node, uint64_t left,
+                                     uint64_t right, uint64_t left_query,
+                                     uint64_t right_query) const {
+  if (right_query < left || left_query > right) {
+    return LLONG_MIN;
+  }
+  if (left_query <= left && right_query >= right) {
+    return pool_[node].val;
+  }
+  uint64_t mid = left + (right - left) / 2;
+  long long res = LLONG_MIN;
+  if (pool_[node].left != 0) {
+    res = GetMax(pool_[node].left, left, mid, left_query, right_query);
+  }
+  if (pool_[node].right != 0) {
+    res = std::max(res, GetMax(pool_[node].right, mid + 1, right, left_query,
+                               right_query));
+  }
+  return res;
+}
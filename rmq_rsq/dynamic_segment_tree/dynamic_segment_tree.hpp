@@ -0,0 +1,56 @@
+/*
+How it works:
+A dynamic (sparse) segment tree covers the whole coordinate space
+[0, 2^64) without ever materializing it. It starts with a single root, and a
+node is created only when an update passes through it, so each update adds at
+most 64 nodes regardless of how sparse the positions are. Positions that have
+never been updated are treated as LLONG_MIN.
+
+Nodes live in one contiguous pool and refer to their children by 32-bit
+indices (0 stands for "no child", since the root at index 0 is never a
+child), which halves the size of child links compared to pointers and avoids
+a heap allocation per node.
+
+The following implementation supports two key operations in O(log C) time,
+where C = 2^64 is the size of the coordinate space:
+1) Finding the maximum element in a range (a[l...r]).
+2) Updating an element to a new value.
+
+Memory Complexity: O(min(q * log C, C)) for q updates
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+class DynamicSegmentTree {
+ public:
+  DynamicSegmentTree(size_t reserved_nodes = 0);
+
+  void Update(uint64_t pos, long long val);
+
+  long long GetMax(uint64_t left, uint64_t right) const {
+    return GetMax(0, 0, UINT64_MAX, left, right);
+  }
+
+  size_t NodeCount() const { return pool_.size(); }
+
+ private:
+  struct Node {
+    long long val = LLONG_MIN;
+    uint32_t left = 0;
+    uint32_t right = 0;
+  };
+
+  static constexpr size_t cMaxDepth = 65;
+
+  std::vector<Node> pool_;
+
+  uint32_t NewNode();
+  long long ValueOf(uint32_t node) const {
+    return node == 0 ? LLONG_MIN : pool_[node].val;
+  }
+  long long GetMax(uint32_t node, uint64_t left, uint64_t right,
+                   uint64_t left_query, uint64_t right_query) const;
+};
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include "dynamic_segment_tree.hpp"
+
+TEST(DynamicSegmentTreeTest, GetMaxSimpleTest) {
+  DynamicSegmentTree tree;
+  EXPECT_EQ(tree.GetMax(0, UINT64_MAX), LLONG_MIN);
+
+  tree.Update(1'700'000'000'000'000'000ULL, 5);
+  tree.Update(3, -7);
+  tree.Update(UINT64_MAX, 10);
+  EXPECT_EQ(tree.GetMax(0, UINT64_MAX), 10);
+  EXPECT_EQ(tree.GetMax(0, 1'700'000'000'000'000'000ULL), 5);
+  EXPECT_EQ(tree.GetMax(0, 100), -7);
+  EXPECT_EQ(tree.GetMax(4, 100), LLONG_MIN);
+
+  tree.Update(UINT64_MAX, 1);
+  EXPECT_EQ(tree.GetMax(0, UINT64_MAX), 5);
+  EXPECT_LE(tree.NodeCount(), 1 + 3 * 64);
+}
+
+TEST(DynamicSegmentTreeTest, StressTest) {
+  std::mt19937_64 rng(std::random_device{}());
+  DynamicSegmentTree tree;
+  std::map<uint64_t, long long> values;
+
+  std::vector<uint64_t> keys;
+  for (size_t i = 0; i < 100; ++i) {
+    keys.push_back(rng());
+  }
+  for (size_t i = 0; i < 5'000; ++i) {
+    uint64_t a = keys[rng() % keys.size()];
+    if (i % 2 == 0) {
+      long long val = static_cast<long long>(rng() % 1'000'000);
+      values[a] = val;
+      tree.Update(a, val);
+    } else {
+      uint64_t b = keys[rng() % keys.size()];
+      uint64_t left = std::min(a, b);
+      uint64_t right = std::max(a, b);
+      long long expected = LLONG_MIN;
+      for (auto it = values.lower_bound(left);
+           it != values.end() && it->first <= right; ++it) {
+        expected = std::max(expected, it->second);
+      }
+      EXPECT_EQ(tree.GetMax(left, right), expected);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
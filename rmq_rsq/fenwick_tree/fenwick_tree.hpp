@@ -12,13 +12,48 @@ result.
 
 Compared to segment tree, fenwick tree is more memory efficient: it uses exactly
 the same space as the original array (n elements).
+
+The tree is built in O(n) time: every cell is complete once all the cells it
+covers have been processed, so it is enough to push each cell into its parent
+(i | (i + 1)) in a single left-to-right pass.
+
+LowerBound(sum) finds the first index whose prefix sum is >= sum (for
+non-negative values) in O(logn) by descending the implicit tree: the answer
+is assembled bit by bit from the highest power of two, and each step looks at
+a single cell instead of running an outer binary search over GetPrefixSum.
+
+RangeFenwickTree adds a value to a whole range and returns range sums, both in
+O(logn). It keeps two trees over the difference array d (d[i] = a[i] - a[i-1]):
+the prefix sum a[0] + ... + a[p] equals
+(p + 1) * (d[0] + ... + d[p]) - (0 * d[0] + 1 * d[1] + ... + p * d[p]).
+
+With the padded layout, one unused cell is inserted after every 63 cells.
+Query and update walks jump by powers of two, and on large power-of-two sizes
+such jumps map to the same L1 cache sets (whose period is 4 KiB), so a walk
+keeps evicting its own lines. A period that is not a power of two turns a jump
+of 2^k cells into 2^k + 2^k / 63 cells (up to rounding), which for every
+2^9 <= 2^k <= 2^39 stays at least one cache line away from a multiple of
+4 KiB. This costs 1.6% of extra memory. The layout is a template parameter,
+so the plain layout indexes its cells directly.
+
+MultiFenwickTree<K> maintains K columns at once. The K counters of an index
+are stored next to each other, so one walk over the tree touches the same
+cache lines as a single-column tree, and the K additions at every step are a
+fixed-size loop the compiler turns into SIMD code.
 */
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
+enum class FenwickLayout { Plain, Padded };
+
+template <FenwickLayout Layout = FenwickLayout::Plain>
 class FenwickTree {
  public:
+  explicit FenwickTree(size_t size);
   FenwickTree(const std::vector<long long>& arr);
 
   void Update(size_t pos, long long val);
@@ -27,7 +62,203 @@ class FenwickTree {
 
   long long GetSum(long long left, long long right) const;
 
+  // Returns the size of the array if the total sum is less than prefix_sum
+  size_t LowerBound(long long prefix_sum) const;
+
+  size_t Size() const { return size_; }
+
  private:
+  static constexpr size_t cPaddingPeriod = 63;
+
   std::vector<long long> fenwick_;
   size_t size_;
-};
\ No newline at end of file
+
+  // Position of the i-th cell in fenwick_
+  static size_t Slot(size_t i) {
+    if constexpr (Layout == FenwickLayout::Padded) {
+      return i + i / cPaddingPeriod;
+    } else {
+      return i;
+    }
+  }
+};
+
+template <FenwickLayout Layout = FenwickLayout::Plain>
+class RangeFenwickTree {
+ public:
+  RangeFenwickTree(const std::vector<long long>& arr);
+
+  void Update(size_t left, size_t right, long long val);
+
+  long long GetPrefixSum(long long pos) const;
+
+  long long GetSum(long long left, long long right) const;
+
+ private:
+  FenwickTree<Layout> diff_;           // d[i]
+  FenwickTree<Layout> weighted_diff_;  // i * d[i]
+
+  static std::vector<long long> Differences(const std::vector<long long>& arr,
+                                            bool weighted);
+};
+
+template <FenwickLayout Layout>
+FenwickTree<Layout>::FenwickTree(size_t size) : size_(size) {
+  fenwick_.resize(size_ == 0 ? 0 : Slot(size_ - 1) + 1);
+}
+
+template <FenwickLayout Layout>
+FenwickTree<Layout>::FenwickTree(const std::vector<long long>& arr)
+    : FenwickTree(arr.size()) {
+  for (size_t i = 0; i < size_; ++i) {
+    fenwick_[Slot(i)] = arr[i];
+  }
+  for (size_t i = 0; i < size_; ++i) {
+    size_t parent = i | (i + 1);
+    if (parent < size_) {
+      fenwick_[Slot(parent)] += fenwick_[Slot(i)];
+    }
+  }
+}
+
+template <FenwickLayout Layout>
+void FenwickTree<Layout>::Update(size_t pos, long long val) {
+  for (size_t i = pos; i < size_; i = (i | (i + 1))) {
+    fenwick_[Slot(i)] += val;
+  }
+}
+
+template <FenwickLayout Layout>
+long long FenwickTree<Layout>::GetPrefixSum(long long pos) const {
+  long long ans = 0;
+  pos = std::min(pos, static_cast<long long>(size_) - 1);
+  for (long long i = pos; i >= 0; i = (i & (i + 1)) - 1) {
+    ans += fenwick_[Slot(i)];
+  }
+  return ans;
+}
+
+template <FenwickLayout Layout>
+long long FenwickTree<Layout>::GetSum(long long left, long long right) const {
+  return GetPrefixSum(right) - GetPrefixSum(left - 1);
+}
+
+template <FenwickLayout Layout>
+size_t FenwickTree<Layout>::LowerBound(long long prefix_sum) const {
+  size_t step = 1;
+  while (step * 2 <= size_) {
+    step *= 2;
+  }
+  size_t pos = 0;  // number of elements whose sum is less than prefix_sum
+  for (; step > 0; step /= 2) {
+    if (pos + step <= size_ && fenwick_[Slot(pos + step - 1)] < prefix_sum) {
+      pos += step;
+      prefix_sum -= fenwick_[Slot(pos - 1)];
+    }
+  }
+  return pos;
+}
+
+template <FenwickLayout Layout>
+RangeFenwickTree<Layout>::RangeFenwickTree(const std::vector<long long>& arr)
+    : diff_(Differences(arr, false)), weighted_diff_(Differences(arr, true)) {}
+
+template <FenwickLayout Layout>
+std::vector<long long> RangeFenwickTree<Layout>::Differences(
+    const std::vector<long long>& arr, bool weighted) {
+  std::vector<long long> diff(arr.size());
+  for (size_t i = 0; i < arr.size(); ++i) {
+    diff[i] = arr[i] - (i > 0 ? arr[i - 1] : 0);
+    if (weighted) {
+      diff[i] *= static_cast<long long>(i);
+    }
+  }
+  return diff;
+}
+
+template <FenwickLayout Layout>
+void RangeFenwickTree<Layout>::Update(size_t left, size_t right,
+                                      long long val) {
+  diff_.Update(left, val);
+  diff_.Update(right + 1, -val);
+  weighted_diff_.Update(left, val * static_cast<long long>(left));
+  weighted_diff_.Update(right + 1, -val * static_cast<long long>(right + 1));
+}
+
+template <FenwickLayout Layout>
+long long RangeFenwickTree<Layout>::GetPrefixSum(long long pos) const {
+  // Clamped here too: the multiplier must match the clamped prefix
+  pos = std::min(pos, static_cast<long long>(diff_.Size()) - 1);
+  return (pos + 1) * diff_.GetPrefixSum(pos) -
+         weighted_diff_.GetPrefixSum(pos);
+}
+
+template <FenwickLayout Layout>
+long long RangeFenwickTree<Layout>::GetSum(long long left,
+                                           long long right) const {
+  return GetPrefixSum(right) - GetPrefixSum(left - 1);
+}
+
+template <size_t K>
+class MultiFenwickTree {
+ public:
+  using Row = std::array<long long, K>;
+
+  MultiFenwickTree(const std::vector<Row>& arr);
+
+  void Update(size_t pos, const Row& val);
+
+  Row GetPrefixSum(long long pos) const;
+
+  Row GetSum(long long left, long long right) const;
+
+ private:
+  std::vector<Row> fenwick_;
+  size_t size_;
+
+  static void Add(Row& dst, const Row& src) {
+    for (size_t k = 0; k < K; ++k) {
+      dst[k] += src[k];
+    }
+  }
+};
+
+template <size_t K>
+MultiFenwickTree<K>::MultiFenwickTree(const std::vector<Row>& arr)
+    : fenwick_(arr), size_(arr.size()) {
+  for (size_t i = 0; i < size_; ++i) {
+    size_t parent = i | (i + 1);
+    if (parent < size_) {
+      Add(fenwick_[parent], fenwick_[i]);
+    }
+  }
+}
+
+template <size_t K>
+void MultiFenwickTree<K>::Update(size_t pos, const Row& val) {
+  for (size_t i = pos; i < size_; i = (i | (i + 1))) {
+    Add(fenwick_[i], val);
+  }
+}
+
+template <size_t K>
+typename MultiFenwickTree<K>::Row MultiFenwickTree<K>::GetPrefixSum(
+    long long pos) const {
+  Row ans{};
+  pos = std::min(pos, static_cast<long long>(size_) - 1);
+  for (long long i = pos; i >= 0; i = (i & (i + 1)) - 1) {
+    Add(ans, fenwick_[i]);
+  }
+  return ans;
+}
+
+template <size_t K>
+typename MultiFenwickTree<K>::Row MultiFenwickTree<K>::GetSum(
+    long long left, long long right) const {
+  Row ans = GetPrefixSum(right);
+  Row prefix = GetPrefixSum(left - 1);
+  for (size_t k = 0; k < K; ++k) {
+    ans[k] -= prefix[k];
+  }
+  return ans;
+}
@@ -8,6 +8,148 @@ TEST(FenwickTreeTest, GetSumSimpleTest) {
   EXPECT_EQ(tree.GetSum(2, 4), -230);
 }
 
+TEST(FenwickTreeTest, StressTest) {
+  const size_t N = 1'000;
+  const long long cMod = 1'000'000;
+  std::srand(std::time(nullptr));
+
+  std::vector<long long> arr(N);
+  for (auto& elem : arr) {
+    elem = std::rand() % cMod - cMod / 2;
+  }
+  FenwickTree tree{arr};
+
+  for (size_t i = 0; i < 10'000; ++i) {
+    size_t left = std::rand() % N;
+    size_t right = left + std::rand() % (N - left);
+    if (i % 2 == 0) {
+      long long delta = std::rand() % cMod - cMod / 2;
+      arr[left] += delta;
+      tree.Update(left, delta);
+    } else {
+      long long expected = 0;
+      for (size_t j = left; j <= right; ++j) {
+        expected += arr[j];
+      }
+      EXPECT_EQ(tree.GetSum(left, right), expected);
+    }
+  }
+}
+
+TEST(FenwickTreeTest, LowerBoundTest) {
+  std::vector<long long> arr{2, 0, 3, 1, 4};  // prefix sums 2 2 5 6 10
+  FenwickTree tree{arr};
+  EXPECT_EQ(tree.LowerBound(0), 0);
+  EXPECT_EQ(tree.LowerBound(2), 0);
+  EXPECT_EQ(tree.LowerBound(3), 2);
+  EXPECT_EQ(tree.LowerBound(6), 3);
+  EXPECT_EQ(tree.LowerBound(7), 4);
+  EXPECT_EQ(tree.LowerBound(11), 5);
+
+  const size_t N = 1'000;
+  std::vector<long long> random(N);
+  for (auto& elem : random) {
+    elem = std::rand() % 10;
+  }
+  FenwickTree random_tree{random};
+  for (size_t i = 0; i < 1'000; ++i) {
+    long long target = std::rand() % (5 * N);
+    size_t expected = 0;
+    long long prefix = 0;
+    while (expected < N && prefix + random[expected] < target) {
+      prefix += random[expected++];
+    }
+    EXPECT_EQ(random_tree.LowerBound(target), expected);
+  }
+}
+
+TEST(FenwickTreeTest, RangeUpdateTest) {
+  std::vector<long long> arr{-100, 200, 70, -300, 0};
+  RangeFenwickTree tree{arr};
+  EXPECT_EQ(tree.GetSum(0, 4), -130);
+  EXPECT_EQ(tree.GetSum(2, 3), -230);
+
+  tree.Update(1, 3, 10);  // -100 210 80 -290 0
+  EXPECT_EQ(tree.GetSum(0, 4), -100);
+  EXPECT_EQ(tree.GetSum(2, 2), 80);
+  tree.Update(0, 4, -1);  // -101 209 79 -291 -1
+  EXPECT_EQ(tree.GetSum(3, 4), -292);
+
+  // Right ends past the array are clamped, as in FenwickTree
+  RangeFenwickTree small{{1, 2, 3, 4}};
+  EXPECT_EQ(small.GetSum(0, 4), 10);
+  EXPECT_EQ(small.GetSum(2, 10), 7);
+  EXPECT_EQ(small.GetPrefixSum(100), 10);
+
+  const size_t N = 500;
+  const long long cMod = 1'000;
+  std::vector<long long> random(N);
+  for (auto& elem : random) {
+    elem = std::rand() % cMod;
+  }
+  RangeFenwickTree random_tree{random};
+  for (size_t i = 0; i < 5'000; ++i) {
+    size_t left = std::rand() % N;
+    size_t right = left + std::rand() % (N - left);
+    if (i % 2 == 0) {
+      long long val = std::rand() % cMod - cMod / 2;
+      random_tree.Update(left, right, val);
+      for (size_t j = left; j <= right; ++j) {
+        random[j] += val;
+      }
+    } else {
+      long long expected = 0;
+      for (size_t j = left; j <= right; ++j) {
+        expected += random[j];
+      }
+      EXPECT_EQ(random_tree.GetSum(left, right), expected);
+    }
+  }
+}
+
+TEST(FenwickTreeTest, PaddedLayoutTest) {
+  std::srand(std::time(nullptr));
+  for (size_t n : {1, 62, 63, 64, 126, 127, 1024, 1027, (1 << 16) + 5,
+                   1 << 17}) {
+    std::vector<long long> arr(n);
+    for (auto& elem : arr) {
+      elem = std::rand() % 100;
+    }
+    FenwickTree plain{arr};
+    FenwickTree<FenwickLayout::Padded> padded{arr};
+
+    for (size_t i = 0; i < 200; ++i) {
+      size_t pos = std::rand() % n;
+      long long delta = std::rand() % 100;
+      plain.Update(pos, delta);
+      padded.Update(pos, delta);
+
+      size_t left = std::rand() % n;
+      size_t right = left + std::rand() % (n - left);
+      EXPECT_EQ(padded.GetSum(left, right), plain.GetSum(left, right));
+
+      long long target = std::rand() % (100 * n);
+      EXPECT_EQ(padded.LowerBound(target), plain.LowerBound(target));
+    }
+  }
+}
+
+TEST(FenwickTreeTest, MultiColumnTest) {
+  using Row = MultiFenwickTree<3>::Row;
+  std::vector<Row> arr{{1, 10, 100}, {2, 20, 200}, {3, 30, 300}, {4, 40, 400}};
+  MultiFenwickTree<3> tree{arr};
+  EXPECT_EQ(tree.GetPrefixSum(3), (Row{10, 100, 1000}));
+  EXPECT_EQ(tree.GetSum(1, 2), (Row{5, 50, 500}));
+
+  tree.Update(2, {-3, 0, 7});
+  EXPECT_EQ(tree.GetSum(1, 3), (Row{6, 90, 907}));
+  EXPECT_EQ(tree.GetPrefixSum(1), (Row{3, 30, 300}));
+
+  // Positions past the end are clamped, as in FenwickTree
+  EXPECT_EQ(tree.GetSum(1, 4), (Row{6, 90, 907}));
+  EXPECT_EQ(tree.GetPrefixSum(100), (Row{7, 100, 1007}));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
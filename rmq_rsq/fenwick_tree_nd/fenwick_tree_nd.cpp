@@ -0,0 +1,62 @@
+#include "fenwick_tree_nd.hpp"
+
+CompressedFenwickTree2D::CompressedFenwickTree2D(
+    const std::vector<std::pair<long long, long long>>& points) {
+  for (const auto& point : points) {
+    xs_.push_back(point.first);
+  }
+  std::sort(xs_.begin(), xs_.end());
+  xs_.erase(std::unique(xs_.begin(), xs_.end()), xs_.end());
+
+  std::vector<std::vector<long long>> inner_ys(xs_.size());
+  for (const auto& [x, y] : points) {
+    size_t i = std::lower_bound(xs_.begin(), xs_.end(), x) - xs_.begin();
+    for (; i < xs_.size(); i = (i | (i + 1))) {
+      inner_ys[i].push_back(y);
+    }
+  }
+
+  offsets_.push_back(0);
+  for (auto& ys : inner_ys) {
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+    ys_.insert(ys_.end(), ys.begin(), ys.end());
+    offsets_.push_back(ys_.size());
+  }
+  fenwick_.resize(ys_.size());
+}
+
+void CompressedFenwickTree2D::Update(long long x, long long y, long long val) {
+  size_t i = std::lower_bound(xs_.begin(), xs_.end(), x) - xs_.begin();
+  for (; i < xs_.size(); i = (i | (i + 1))) {
+    auto begin = ys_.begin() + offsets_[i];
+    auto end = ys_.begin() + offsets_[i + 1];
+    size_t size = offsets_[i + 1] - offsets_[i];
+    for (size_t j = std::lower_bound(begin, end, y) - begin; j < size;
+         j = (j | (j + 1))) {
+      fenwick_[offsets_[i] + j] += val;
+    }
+  }
+}
+
+long long CompressedFenwickTree2D::GetPrefixSum(long long x,
+                                                long long y) const {
+  long long ans = 0;
+  long long i = std::upper_bound(xs_.begin(), xs_.end(), x) - xs_.begin() - 1;
+  for (; i >= 0; i = (i & (i + 1)) - 1) {
+    auto begin = ys_.begin() + offsets_[i];
+    auto end = ys_.begin() + offsets_[i + 1];
+    for (long long j = std::upper_bound(begin, end, y) - begin - 1; j >= 0;
+         j = (j & (j + 1)) - 1) {
+      ans += fenwick_[offsets_[i] + j];
+    }
+  }
+  return ans;
+}
+
+long long CompressedFenwickTree2D::GetSum(long long x_low, long long y_low,
+                                          long long x_high,
+                                          long long y_high) const {
+  return GetPrefixSum(x_high, y_high) - GetPrefixSum(x_low - 1, y_high) -
+         GetPrefixSum(x_high, y_low - 1) + GetPrefixSum(x_low - 1, y_low - 1);
+}
@@ -0,0 +1,126 @@
+/*
+How it works:
+A multidimensional Fenwick tree is a Fenwick tree over Fenwick trees: every
+cell chosen by the usual index walk along the first coordinate is itself a
+(D-1)-dimensional tree. An update or a prefix query walks O(logn) indices in
+each dimension, so both run in O(log^D n).
+
+FenwickTreeND<D> stores the whole D-dimensional array in one flat row-major
+vector (no per-row allocations), and a query over a box [low, high] is
+assembled from 2^D prefix queries by inclusion-exclusion.
+
+CompressedFenwickTree2D is meant for sparse grids, where a dense
+(width x height) array does not fit in memory. All points that will ever be
+updated are passed to the constructor; every cell of the outer tree then keeps
+only the sorted y-coordinates of the points that can reach it, so the memory
+is O(k logk) for k points while updates and rectangle queries still take
+O(log^2 k). The inner trees are stored back to back in flat arrays.
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+template <size_t D>
+class FenwickTreeND {
+ public:
+  using Point = std::array<size_t, D>;
+
+  FenwickTreeND(const Point& dims);
+
+  void Update(const Point& pos, long long val) { Update(0, 0, pos, val); }
+
+  long long GetPrefixSum(const Point& pos) const {
+    return GetPrefixSum(0, 0, pos);
+  }
+
+  long long GetSum(const Point& low, const Point& high) const;
+
+ private:
+  Point dims_;
+  Point strides_;
+  std::vector<long long> fenwick_;
+
+  void Update(size_t dim, size_t offset, const Point& pos, long long val);
+  long long GetPrefixSum(size_t dim, size_t offset, const Point& pos) const;
+};
+
+template <size_t D>
+FenwickTreeND<D>::FenwickTreeND(const Point& dims) : dims_(dims) {
+  size_t total = 1;
+  for (size_t dim = D; dim-- > 0;) {
+    strides_[dim] = total;
+    total *= dims_[dim];
+  }
+  fenwick_.resize(total);
+}
+
+template <size_t D>
+void FenwickTreeND<D>::Update(size_t dim, size_t offset, const Point& pos,
+                              long long val) {
+  for (size_t i = pos[dim]; i < dims_[dim]; i = (i | (i + 1))) {
+    if (dim + 1 == D) {
+      fenwick_[offset + i] += val;
+    } else {
+      Update(dim + 1, offset + i * strides_[dim], pos, val);
+    }
+  }
+}
+
+template <size_t D>
+long long FenwickTreeND<D>::GetPrefixSum(size_t dim, size_t offset,
+                                         const Point& pos) const {
+  long long ans = 0;
+  for (long long i = static_cast<long long>(pos[dim]); i >= 0;
+       i = (i & (i + 1)) - 1) {
+    if (dim + 1 == D) {
+      ans += fenwick_[offset + i];
+    } else {
+      ans += GetPrefixSum(dim + 1, offset + i * strides_[dim], pos);
+    }
+  }
+  return ans;
+}
+
+template <size_t D>
+long long FenwickTreeND<D>::GetSum(const Point& low, const Point& high) const {
+  long long ans = 0;
+  for (size_t mask = 0; mask < (size_t{1} << D); ++mask) {
+    Point corner = high;
+    bool empty = false;
+    for (size_t dim = 0; dim < D; ++dim) {
+      if ((mask >> dim) & 1) {
+        empty |= low[dim] == 0;
+        corner[dim] = low[dim] - 1;
+      }
+    }
+    if (empty) {
+      continue;
+    }
+    long long prefix = GetPrefixSum(corner);
+    ans += __builtin_popcountll(mask) % 2 == 0 ? prefix : -prefix;
+  }
+  return ans;
+}
+
+class CompressedFenwickTree2D {
+ public:
+  CompressedFenwickTree2D(
+      const std::vector<std::pair<long long, long long>>& points);
+
+  // (x, y) must be one of the points passed to the constructor
+  void Update(long long x, long long y, long long val);
+
+  long long GetPrefixSum(long long x, long long y) const;
+
+  long long GetSum(long long x_low, long long y_low, long long x_high,
+                   long long y_high) const;
+
+ private:
+  std::vector<long long> xs_;
+  std::vector<size_t> offsets_;  // inner tree i is [offsets_[i], offsets_[i+1])
+  std::vector<long long> ys_;
+  std::vector<long long> fenwick_;
+};
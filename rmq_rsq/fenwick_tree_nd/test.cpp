@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "fenwick_tree_nd.hpp"
+
+TEST(FenwickTreeNDTest, Grid2DTest) {
+  FenwickTreeND<2> tree({3, 4});
+  tree.Update({0, 0}, 1);
+  tree.Update({1, 2}, 5);
+  tree.Update({2, 3}, -2);
+
+  EXPECT_EQ(tree.GetPrefixSum({2, 3}), 4);
+  EXPECT_EQ(tree.GetPrefixSum({1, 1}), 1);
+  EXPECT_EQ(tree.GetSum({1, 1}, {2, 3}), 3);
+  EXPECT_EQ(tree.GetSum({1, 3}, {2, 3}), -2);
+}
+
+TEST(FenwickTreeNDTest, StressTest3D) {
+  const size_t N = 6;
+  std::srand(std::time(nullptr));
+  FenwickTreeND<3> tree({N, N + 1, N + 2});
+  long long grid[N][N + 1][N + 2] = {};
+
+  for (size_t iter = 0; iter < 1'000; ++iter) {
+    size_t x = std::rand() % N;
+    size_t y = std::rand() % (N + 1);
+    size_t z = std::rand() % (N + 2);
+    if (iter % 2 == 0) {
+      long long val = std::rand() % 100 - 50;
+      grid[x][y][z] += val;
+      tree.Update({x, y, z}, val);
+    } else {
+      long long expected = 0;
+      for (size_t i = x; i < N; ++i) {
+        for (size_t j = y; j < N + 1; ++j) {
+          for (size_t k = z; k < N + 2; ++k) {
+            expected += grid[i][j][k];
+          }
+        }
+      }
+      EXPECT_EQ(tree.GetSum({x, y, z}, {N - 1, N, N + 1}), expected);
+    }
+  }
+}
+
+TEST(FenwickTreeNDTest, CompressedTest) {
+  std::vector<std::pair<long long, long long>> points;
+  const long long cMod = 1'000'000'000;
+  for (size_t i = 0; i < 300; ++i) {
+    points.emplace_back(std::rand() % cMod, std::rand() % cMod);
+  }
+  CompressedFenwickTree2D tree{points};
+  std::vector<long long> values(points.size());
+
+  for (size_t iter = 0; iter < 2'000; ++iter) {
+    size_t idx = std::rand() % points.size();
+    if (iter % 2 == 0) {
+      long long val = std::rand() % 100;
+      values[idx] += val;
+      tree.Update(points[idx].first, points[idx].second, val);
+    } else {
+      size_t other = std::rand() % points.size();
+      long long x_low = std::min(points[idx].first, points[other].first);
+      long long x_high = std::max(points[idx].first, points[other].first);
+      long long y_low = std::min(points[idx].second, points[other].second);
+      long long y_high = std::max(points[idx].second, points[other].second);
+
+      long long expected = 0;
+      for (size_t i = 0; i < points.size(); ++i) {
+        auto [x, y] = points[i];
+        if (x_low <= x && x <= x_high && y_low <= y && y <= y_high) {
+          expected += values[i];
+        }
+      }
+      EXPECT_EQ(tree.GetSum(x_low, y_low, x_high, y_high), expected);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,161 @@
+/*
+How it works:
+This is a non-recursive (bottom-up) version of the segment tree. The tree is
+stored in an array of 2n elements: the leaves a[0...n-1] occupy positions
+n...2n-1, and every inner node i aggregates its children 2i and 2i+1.
+
+A point update changes the leaf and recalculates its ancestors by walking up
+to the root. A range query starts from both borders of the segment at the
+leaf level and moves them towards each other one level at a time, picking up
+the nodes that lie entirely inside the segment.
+
+The tree is templated on a monoid (see rmq_rsq/monoid.hpp), so the same code
+serves sum, min, max, gcd or any custom associative operation. The order of
+operands is preserved, hence the operation does not have to be commutative.
+
+Both operations work in O(logn) time without recursion, and the memory
+complexity is exactly 2n.
+
+Besides, the tree supports binary search by descent in O(logn) time: given a
+monotone predicate pred with pred(Identity()) == true,
+ * MaxRight(l, pred) returns the largest r such that pred(a[l] * ... * a[r-1])
+ * MinLeft(r, pred) returns the smallest l such that pred(a[l] * ... * a[r-1])
+E.g. MaxRight(l, [x](Value v) { return v < x; }) over the max monoid finds the
+first position in [l, n) whose value is >= x (n if there is none). The segment
+is first split into its O(logn) canonical nodes; the first node that breaks
+the predicate is then descended to a leaf.
+*/
+
+#include <cstddef>
+#include <vector>
+
+#include "../monoid.hpp"
+
+template <typename Monoid>
+class IterativeSegmentTree {
+ public:
+  using Value = typename Monoid::Value;
+
+  IterativeSegmentTree(const std::vector<Value>& arr);
+
+  void Update(size_t pos, const Value& val);
+  Value Get(size_t pos) const { return tree_[size_ + pos]; }
+  Value Query(size_t left, size_t right) const;  // [left, right]
+  size_t Size() const { return size_; }
+
+  template <typename Pred>
+  size_t MaxRight(size_t left, Pred pred) const;
+  template <typename Pred>
+  size_t MinLeft(size_t right, Pred pred) const;
+
+ private:
+  static constexpr size_t cMaxNodes = 64;
+
+  size_t size_;
+  std::vector<Value> tree_;
+
+  // Writes the canonical nodes of [left, right) in left-to-right order
+  size_t Decompose(size_t left, size_t right, size_t* nodes) const;
+};
+
+template <typename Monoid>
+IterativeSegmentTree<Monoid>::IterativeSegmentTree(
+    const std::vector<Value>& arr)
+    : size_(arr.size()), tree_(2 * arr.size(), Monoid::Identity()) {
+  std::copy(arr.begin(), arr.end(), tree_.begin() + size_);
+  for (size_t node = size_; node-- > 1;) {
+    tree_[node] = Monoid::Combine(tree_[2 * node], tree_[2 * node + 1]);
+  }
+}
+
+template <typename Monoid>
+void IterativeSegmentTree<Monoid>::Update(size_t pos, const Value& val) {
+  size_t node = size_ + pos;
+  tree_[node] = val;
+  for (node /= 2; node > 0; node /= 2) {
+    tree_[node] = Monoid::Combine(tree_[2 * node], tree_[2 * node + 1]);
+  }
+}
+
+template <typename Monoid>
+typename IterativeSegmentTree<Monoid>::Value
+IterativeSegmentTree<Monoid>::Query(size_t left, size_t right) const {
+  Value left_res = Monoid::Identity();
+  Value right_res = Monoid::Identity();
+  for (left += size_, right += size_ + 1; left < right;
+       left /= 2, right /= 2) {
+    if (left % 2 == 1) {
+      left_res = Monoid::Combine(left_res, tree_[left++]);
+    }
+    if (right % 2 == 1) {
+      right_res = Monoid::Combine(tree_[--right], right_res);
+    }
+  }
+  return Monoid::Combine(left_res, right_res);
+}
+
+template <typename Monoid>
+size_t IterativeSegmentTree<Monoid>::Decompose(size_t left, size_t right,
+                                               size_t* nodes) const {
+  size_t right_nodes[cMaxNodes];
+  size_t left_count = 0;
+  size_t right_count = 0;
+  for (left += size_, right += size_; left < right; left /= 2, right /= 2) {
+    if (left % 2 == 1) {
+      nodes[left_count++] = left++;
+    }
+    if (right % 2 == 1) {
+      right_nodes[right_count++] = --right;
+    }
+  }
+  while (right_count > 0) {
+    nodes[left_count++] = right_nodes[--right_count];
+  }
+  return left_count;
+}
+
+template <typename Monoid>
+template <typename Pred>
+size_t IterativeSegmentTree<Monoid>::MaxRight(size_t left, Pred pred) const {
+  size_t nodes[2 * cMaxNodes];
+  size_t count = Decompose(left, size_, nodes);
+  Value acc = Monoid::Identity();
+  for (size_t i = 0; i < count; ++i) {
+    size_t node = nodes[i];
+    if (!pred(Monoid::Combine(acc, tree_[node]))) {
+      while (node < size_) {
+        node = 2 * node;
+        if (pred(Monoid::Combine(acc, tree_[node]))) {
+          acc = Monoid::Combine(acc, tree_[node]);
+          ++node;
+        }
+      }
+      return node - size_;
+    }
+    acc = Monoid::Combine(acc, tree_[node]);
+  }
+  return size_;
+}
+
+template <typename Monoid>
+template <typename Pred>
+size_t IterativeSegmentTree<Monoid>::MinLeft(size_t right, Pred pred) const {
+  size_t nodes[2 * cMaxNodes];
+  size_t count = Decompose(0, right, nodes);
+  Value acc = Monoid::Identity();
+  for (size_t i = count; i-- > 0;) {
+    size_t node = nodes[i];
+    if (!pred(Monoid::Combine(tree_[node], acc))) {
+      while (node < size_) {
+        node = 2 * node + 1;
+        if (pred(Monoid::Combine(tree_[node], acc))) {
+          acc = Monoid::Combine(tree_[node], acc);
+          --node;
+        }
+      }
+      return node + 1 - size_;
+    }
+    acc = Monoid::Combine(tree_[node], acc);
+  }
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "iterative_segment_tree.hpp"
+
+struct ConcatMonoid {
+  using Value = std::string;
+  static Value Identity() { return ""; }
+  static Value Combine(const Value& a, const Value& b) { return a + b; }
+};
+
+TEST(IterativeSegmentTreeTest, MaxTest) {
+  std::vector<long long> arr{-100, 200, 70, -300, 0};
+  IterativeSegmentTree<MaxMonoid<long long>> tree{arr};
+  EXPECT_EQ(tree.Query(0, 4), 200);
+  EXPECT_EQ(tree.Query(2, 4), 70);
+  EXPECT_EQ(tree.Query(3, 3), -300);
+
+  tree.Update(3, 500);
+  EXPECT_EQ(tree.Query(2, 4), 500);
+  EXPECT_EQ(tree.Get(3), 500);
+}
+
+TEST(IterativeSegmentTreeTest, SumMinGcdTest) {
+  std::vector<long long> arr{12, 18, 6, 9, 30};
+  IterativeSegmentTree<SumMonoid<long long>> sum{arr};
+  IterativeSegmentTree<MinMonoid<long long>> min{arr};
+  IterativeSegmentTree<GcdMonoid<long long>> gcd{arr};
+
+  EXPECT_EQ(sum.Query(1, 3), 33);
+  EXPECT_EQ(min.Query(0, 1), 12);
+  EXPECT_EQ(gcd.Query(0, 2), 6);
+  EXPECT_EQ(gcd.Query(2, 4), 3);
+}
+
+TEST(IterativeSegmentTreeTest, NonCommutativeTest) {
+  std::vector<std::string> arr{"a", "b", "c", "d", "e", "f", "g"};
+  IterativeSegmentTree<ConcatMonoid> tree{arr};
+  EXPECT_EQ(tree.Query(0, 6), "abcdefg");
+  EXPECT_EQ(tree.Query(1, 5), "bcdef");
+
+  tree.Update(3, "X");
+  EXPECT_EQ(tree.Query(2, 4), "cXe");
+}
+
+TEST(IterativeSegmentTreeTest, StressTest) {
+  const size_t N = 1000;
+  const long long cMod = 1'000'000;
+  std::srand(std::time(nullptr));
+
+  std::vector<long long> arr(N);
+  for (auto& elem : arr) {
+    elem = std::rand() % cMod - cMod / 2;
+  }
+  IterativeSegmentTree<MinMonoid<long long>> tree{arr};
+
+  for (size_t i = 0; i < 10'000; ++i) {
+    if (i % 2 == 0) {
+      size_t pos = std::rand() % N;
+      arr[pos] = std::rand() % cMod - cMod / 2;
+      tree.Update(pos, arr[pos]);
+    } else {
+      size_t left = std::rand() % N;
+      size_t right = left + std::rand() % (N - left);
+      EXPECT_EQ(tree.Query(left, right),
+                *std::min_element(arr.begin() + left, arr.begin() + right + 1));
+    }
+  }
+}
+
+TEST(IterativeSegmentTreeTest, DescentTest) {
+  std::vector<long long> arr{3, 1, 4, 1, 5, 9, 2, 6};
+  IterativeSegmentTree<MaxMonoid<long long>> max{arr};
+  IterativeSegmentTree<SumMonoid<long long>> sum{arr};
+
+  auto less_than = [](long long x) {
+    return [x](long long v) { return v < x; };
+  };
+  EXPECT_EQ(max.MaxRight(0, less_than(4)), 2);
+  EXPECT_EQ(max.MaxRight(3, less_than(6)), 5);
+  EXPECT_EQ(max.MaxRight(6, less_than(10)), 8);
+  EXPECT_EQ(max.MinLeft(8, less_than(6)), 8);
+  EXPECT_EQ(max.MinLeft(5, less_than(5)), 5);
+  EXPECT_EQ(max.MinLeft(4, less_than(4)), 3);
+
+  auto at_most = [](long long x) {
+    return [x](long long v) { return v <= x; };
+  };
+  EXPECT_EQ(sum.MaxRight(0, at_most(8)), 3);  // 3 + 1 + 4
+  EXPECT_EQ(sum.MinLeft(8, at_most(8)), 6);   // 2 + 6
+}
+
+TEST(IterativeSegmentTreeTest, DescentStressTest) {
+  const long long cMod = 1'000;
+  std::srand(std::time(nullptr));
+
+  for (size_t n = 1; n <= 70; ++n) {
+    std::vector<long long> arr(n);
+    for (auto& elem : arr) {
+      elem = std::rand() % cMod;
+    }
+    IterativeSegmentTree<SumMonoid<long long>> tree{arr};
+
+    for (size_t i = 0; i < 200; ++i) {
+      size_t border = std::rand() % (n + 1);
+      long long limit = std::rand() % (cMod * 10);
+      auto pred = [limit](long long v) { return v <= limit; };
+
+      size_t right = border;
+      long long acc = 0;
+      while (right < n && acc + arr[right] <= limit) {
+        acc += arr[right++];
+      }
+      EXPECT_EQ(tree.MaxRight(border, pred), right);
+
+      size_t left = border;
+      acc = 0;
+      while (left > 0 && acc + arr[left - 1] <= limit) {
+        acc += arr[--left];
+      }
+      EXPECT_EQ(tree.MinLeft(border, pred), left);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
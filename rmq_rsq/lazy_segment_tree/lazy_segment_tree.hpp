@@ -0,0 +1,190 @@
+/*
+How it works:
+A segment tree with lazy propagation supports updates of a whole range
+a[l...r] in O(logn) time. Instead of descending to every leaf of the range, an
+update stops at the O(logn) nodes that cover the range entirely, changes their
+aggregated values and leaves a pending update (a "tag") in them. The tag is
+pushed down to the children only when a later operation needs to descend
+through the node.
+
+The tree is templated on two parameters:
+1) Monoid: the aggregated operation (see rmq_rsq/monoid.hpp).
+2) Action: the range update. An action provides a Tag type, its Identity()
+(no pending update), Compose(newer, older) to merge two pending updates, and
+Apply(tag, value, len) to update an aggregate of a segment of length len.
+
+The following actions are available:
+ * RangeAdd: a[i] += x (valid for sum, min and max)
+ * RangeAssign: a[i] = x (valid for sum, min, max and gcd)
+ * RangeChmin: a[i] = min(a[i], x) (valid for min and max)
+ * RangeChmax: a[i] = max(a[i], x) (valid for min and max)
+
+Both range updates and range queries work in O(logn) time, and the memory
+complexity is 4n values and 4n tags.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "../monoid.hpp"
+
+template <typename Monoid>
+struct RangeAdd {
+  using Value = typename Monoid::Value;
+  using Tag = Value;
+  static Tag Identity() { return Value{}; }
+  static Tag Compose(const Tag& newer, const Tag& older) {
+    return newer + older;
+  }
+  static Value Apply(const Tag& tag, const Value& val, size_t len) {
+    return val + Monoid::Repeat(tag, len);
+  }
+};
+
+template <typename Monoid>
+struct RangeAssign {
+  using Value = typename Monoid::Value;
+  using Tag = std::optional<Value>;
+  static Tag Identity() { return std::nullopt; }
+  static Tag Compose(const Tag& newer, const Tag& older) {
+    return newer.has_value() ? newer : older;
+  }
+  static Value Apply(const Tag& tag, const Value& val, size_t len) {
+    return tag.has_value() ? Monoid::Repeat(*tag, len) : val;
+  }
+};
+
+template <typename Monoid>
+struct RangeChmin {
+  using Value = typename Monoid::Value;
+  using Tag = Value;
+  static Tag Identity() { return std::numeric_limits<Value>::max(); }
+  static Tag Compose(const Tag& newer, const Tag& older) {
+    return std::min(newer, older);
+  }
+  static Value Apply(const Tag& tag, const Value& val, size_t /*len*/) {
+    return std::min(val, tag);
+  }
+};
+
+template <typename Monoid>
+struct RangeChmax {
+  using Value = typename Monoid::Value;
+  using Tag = Value;
+  static Tag Identity() { return std::numeric_limits<Value>::lowest(); }
+  static Tag Compose(const Tag& newer, const Tag& older) {
+    return std::max(newer, older);
+  }
+  static Value Apply(const Tag& tag, const Value& val, size_t /*len*/) {
+    return std::max(val, tag);
+  }
+};
+
+template <typename Monoid, typename Action>
+class LazySegmentTree {
+ public:
+  using Value = typename Monoid::Value;
+  using Tag = typename Action::Tag;
+
+  LazySegmentTree(const std::vector<Value>& arr);
+
+  void Update(size_t left, size_t right, const Tag& tag) {
+    Update(1, 0, size_ - 1, left, right, tag);
+  }
+
+  Value Query(size_t left, size_t right) {
+    return Query(1, 0, size_ - 1, left, right);
+  }
+
+ private:
+  std::vector<Value> tree_;
+  std::vector<Tag> tags_;
+  size_t size_;
+
+  void Build(const std::vector<Value>& arr, size_t left, size_t right,
+             size_t node);
+  void ApplyTag(size_t node, size_t left, size_t right, const Tag& tag);
+  void Push(size_t node, size_t left, size_t right);
+  void Update(size_t node, size_t left, size_t right, size_t left_query,
+              size_t right_query, const Tag& tag);
+  Value Query(size_t node, size_t left, size_t right, size_t left_query,
+              size_t right_query);
+};
+
+template <typename Monoid, typename Action>
+LazySegmentTree<Monoid, Action>::LazySegmentTree(const std::vector<Value>& arr)
+    : tree_(4 * arr.size()),
+      tags_(4 * arr.size(), Action::Identity()),
+      size_(arr.size()) {
+  Build(arr, 0, size_ - 1, 1);
+}
+
+template <typename Monoid, typename Action>
+void LazySegmentTree<Monoid, Action>::Build(const std::vector<Value>& arr,
+                                            size_t left, size_t right,
+                                            size_t node) {
+  if (left == right) {
+    tree_[node] = arr[left];
+  } else {
+    size_t mid = (left + right) / 2;
+    Build(arr, left, mid, node * 2);
+    Build(arr, mid + 1, right, node * 2 + 1);
+    tree_[node] = Monoid::Combine(tree_[2 * node], tree_[2 * node + 1]);
+  }
+}
+
+template <typename Monoid, typename Action>
+void LazySegmentTree<Monoid, Action>::ApplyTag(size_t node, size_t left,
+                                               size_t right, const Tag& tag) {
+  tree_[node] = Action::Apply(tag, tree_[node], right - left + 1);
+  tags_[node] = Action::Compose(tag, tags_[node]);
+}
+
+template <typename Monoid, typename Action>
+void LazySegmentTree<Monoid, Action>::Push(size_t node, size_t left,
+                                           size_t right) {
+  size_t mid = (left + right) / 2;
+  ApplyTag(2 * node, left, mid, tags_[node]);
+  ApplyTag(2 * node + 1, mid + 1, right, tags_[node]);
+  tags_[node] = Action::Identity();
+}
+
+template <typename Monoid, typename Action>
+void LazySegmentTree<Monoid, Action>::Update(size_t node, size_t left,
+                                             size_t right, size_t left_query,
+                                             size_t right_query,
+                                             const Tag& tag) {
+  if (right_query < left || left_query > right) {
+    return;
+  }
+  if (left_query <= left && right_query >= right) {
+    ApplyTag(node, left, right, tag);
+    return;
+  }
+  Push(node, left, right);
+  size_t mid = (left + right) / 2;
+  Update(2 * node, left, mid, left_query, right_query, tag);
+  Update(2 * node + 1, mid + 1, right, left_query, right_query, tag);
+  tree_[node] = Monoid::Combine(tree_[2 * node], tree_[2 * node + 1]);
+}
+
+template <typename Monoid, typename Action>
+typename LazySegmentTree<Monoid, Action>::Value
+LazySegmentTree<Monoid, Action>::Query(size_t node, size_t left, size_t right,
+                                       size_t left_query, size_t right_query) {
+  if (right_query < left || left_query > right) {
+    return Monoid::Identity();
+  }
+  if (left_query <= left && right_query >= right) {
+    return tree_[node];
+  }
+  Push(node, left, right);
+  size_t mid = (left + right) / 2;
+  Value left_res = Query(2 * node, left, mid, left_query, right_query);
+  Value right_res =
+      Query(2 * node + 1, mid + 1, right, left_query, right_query);
+  return Monoid::Combine(left_res, right_res);
+}
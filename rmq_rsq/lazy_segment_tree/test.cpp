@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "lazy_segment_tree.hpp"
+
+using Long = long long;
+
+TEST(LazySegmentTreeTest, RangeAddSumTest) {
+  std::vector<Long> arr{1, 2, 3, 4, 5};
+  LazySegmentTree<SumMonoid<Long>, RangeAdd<SumMonoid<Long>>> tree{arr};
+  EXPECT_EQ(tree.Query(0, 4), 15);
+
+  tree.Update(1, 3, 10);  // 1 12 13 14 5
+  EXPECT_EQ(tree.Query(0, 4), 45);
+  EXPECT_EQ(tree.Query(2, 2), 13);
+  EXPECT_EQ(tree.Query(3, 4), 19);
+}
+
+TEST(LazySegmentTreeTest, RangeAssignMaxTest) {
+  std::vector<Long> arr{-100, 200, 70, -300, 0};
+  LazySegmentTree<MaxMonoid<Long>, RangeAssign<MaxMonoid<Long>>> tree{arr};
+  EXPECT_EQ(tree.Query(0, 4), 200);
+
+  tree.Update(0, 2, -5);  // -5 -5 -5 -300 0
+  EXPECT_EQ(tree.Query(0, 4), 0);
+  EXPECT_EQ(tree.Query(1, 3), -5);
+}
+
+TEST(LazySegmentTreeTest, RangeChminChmaxTest) {
+  std::vector<Long> arr{5, 1, 9, 3};
+  LazySegmentTree<MaxMonoid<Long>, RangeChmin<MaxMonoid<Long>>> max{arr};
+  LazySegmentTree<MinMonoid<Long>, RangeChmax<MinMonoid<Long>>> min{arr};
+
+  max.Update(1, 3, 4);  // 5 1 4 3
+  EXPECT_EQ(max.Query(0, 3), 5);
+  EXPECT_EQ(max.Query(1, 3), 4);
+
+  min.Update(0, 2, 6);  // 6 6 9 3
+  EXPECT_EQ(min.Query(0, 2), 6);
+  EXPECT_EQ(min.Query(0, 3), 3);
+}
+
+template <typename Action, typename Monoid, typename Op>
+void StressTest(Op apply) {
+  const size_t N = 500;
+  const Long cMod = 1000;
+
+  std::vector<Long> arr(N);
+  for (auto& elem : arr) {
+    elem = std::rand() % cMod;
+  }
+  LazySegmentTree<Monoid, Action> tree{arr};
+
+  for (size_t i = 0; i < 5'000; ++i) {
+    size_t left = std::rand() % N;
+    size_t right = left + std::rand() % (N - left);
+    if (i % 2 == 0) {
+      Long val = std::rand() % cMod;
+      tree.Update(left, right, val);
+      for (size_t j = left; j <= right; ++j) {
+        arr[j] = apply(arr[j], val);
+      }
+    } else {
+      Long expected = Monoid::Identity();
+      for (size_t j = left; j <= right; ++j) {
+        expected = Monoid::Combine(expected, arr[j]);
+      }
+      EXPECT_EQ(tree.Query(left, right), expected);
+    }
+  }
+}
+
+TEST(LazySegmentTreeTest, StressTest) {
+  std::srand(std::time(nullptr));
+  auto add = [](Long a, Long b) { return a + b; };
+  auto assign = [](Long, Long b) { return b; };
+  auto chmin = [](Long a, Long b) { return std::min(a, b); };
+
+  StressTest<RangeAdd<SumMonoid<Long>>, SumMonoid<Long>>(add);
+  StressTest<RangeAdd<MinMonoid<Long>>, MinMonoid<Long>>(add);
+  StressTest<RangeAssign<SumMonoid<Long>>, SumMonoid<Long>>(assign);
+  StressTest<RangeAssign<GcdMonoid<Long>>, GcdMonoid<Long>>(assign);
+  StressTest<RangeChmin<MaxMonoid<Long>>, MaxMonoid<Long>>(chmin);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+/*
+Monoids shared by the templated RMQ/RSQ data structures.
+
+A monoid is a set of values with an associative binary operation and an
+identity element. Each monoid below exposes:
+ * Value: the type of stored values
+ * Identity(): the neutral element, i.e. Combine(Identity(), x) == x
+ * Combine(a, b): the associative operation
+ * Repeat(a, count): a combined with itself count times (count > 0), used to
+   apply a range-wide update to an aggregate in O(1)
+ * cIdempotent: Combine(a, a) == a, so overlapping segments may be combined
+ * cSelective: Combine(a, b) is always either a or b (a "winner" is chosen)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+
+template <typename T>
+struct SumMonoid {
+  using Value = T;
+  static constexpr bool cIdempotent = false;
+  static constexpr bool cSelective = false;
+  static Value Identity() { return T{}; }
+  static Value Combine(const Value& a, const Value& b) { return a + b; }
+  static Value Repeat(const Value& a, size_t count) {
+    return a * static_cast<Value>(count);
+  }
+};
+
+template <typename T>
+struct MinMonoid {
+  using Value = T;
+  static constexpr bool cIdempotent = true;
+  static constexpr bool cSelective = true;
+  static Value Identity() { return std::numeric_limits<T>::max(); }
+  static Value Combine(const Value& a, const Value& b) {
+    return std::min(a, b);
+  }
+  static Value Repeat(const Value& a, size_t /*count*/) { return a; }
+};
+
+template <typename T>
+struct MaxMonoid {
+  using Value = T;
+  static constexpr bool cIdempotent = true;
+  static constexpr bool cSelective = true;
+  static Value Identity() { return std::numeric_limits<T>::lowest(); }
+  static Value Combine(const Value& a, const Value& b) {
+    return std::max(a, b);
+  }
+  static Value Repeat(const Value& a, size_t /*count*/) { return a; }
+};
+
+template <typename T>
+struct GcdMonoid {
+  using Value = T;
+  static constexpr bool cIdempotent = true;
+  static constexpr bool cSelective = false;
+  static Value Identity() { return T{}; }
+  static Value Combine(const Value& a, const Value& b) {
+    return std::gcd(a, b);
+  }
+  static Value Repeat(const Value& a, size_t /*count*/) { return a; }
+};
+
+template <typename T>
+struct AndMonoid {
+  using Value = T;
+  static constexpr bool cIdempotent = true;
+  static constexpr bool cSelective = false;
+  static Value Identity() { return ~T{}; }
+  static Value Combine(const Value& a, const Value& b) { return a & b; }
+  static Value Repeat(const Value& a, size_t /*count*/) { return a; }
+};
+
+template <typename T>
+struct OrMonoid {
+  using Value = T;
+  static constexpr bool cIdempotent = true;
+  static constexpr bool cSelective = false;
+  static Value Identity() { return T{}; }
+  static Value Combine(const Value& a, const Value& b) { return a | b; }
+  static Value Repeat(const Value& a, size_t /*count*/) { return a; }
+};
@@ -0,0 +1,110 @@
+#include "persistent_segment_tree.hpp"
+
+PersistentSegmentTree::PersistentSegmentTree(const std::vector<long long>& arr)
+    : size_(arr.size()) {
+  arena_.reserve(2 * size_);
+  roots_.push_back(Build(arr, 0, size_ - 1));
+  arena_ends_.push_back(arena_.size());
+}
+
+size_t PersistentSegmentTree::Update(size_t version, size_t pos,
+                                     long long val) {
+  roots_.push_back(
+      Update(roots_[version - first_version_], 0, size_ - 1, pos, val));
+  arena_ends_.push_back(arena_.size());
+  return LastVersion();
+}
+
+void PersistentSegmentTree::Rollback(size_t version) {
+  size_t kept = version - first_version_ + 1;
+  roots_.resize(kept);
+  arena_ends_.resize(kept);
+  arena_.resize(arena_ends_.back());
+}
+
+void PersistentSegmentTree::DiscardBefore(size_t version) {
+  size_t dropped = version - first_version_;
+  std::vector<Node> new_arena;
+  new_arena.reserve(arena_.size() - arena_ends_[dropped] + 2 * size_);
+  std::vector<uint32_t> remap(arena_.size(), cNoNode);
+
+  std::vector<uint32_t> new_roots;
+  std::vector<size_t> new_arena_ends;
+  for (size_t i = dropped; i < roots_.size(); ++i) {
+    new_roots.push_back(CopyReachable(roots_[i], new_arena, remap));
+    new_arena_ends.push_back(new_arena.size());
+  }
+
+  arena_ = std::move(new_arena);
+  roots_ = std::move(new_roots);
+  arena_ends_ = std::move(new_arena_ends);
+  first_version_ = version;
+}
+
+uint32_t PersistentSegmentTree::NewNode(long long val, uint32_t left,
+                                        uint32_t right) {
+  arena_.push_back({val, left, right});
+  return arena_.size() - 1;
+}
+
+uint32_t PersistentSegmentTree::Build(const std::vector<long long>& arr,
+                                      size_t left, size_t right) {
+  if (left == right) {
+    return NewNode(arr[left], cNoNode, cNoNode);
+  }
+  size_t mid = (left + right) / 2;
+  uint32_t left_child = Build(arr, left, mid);
+  uint32_t right_child = Build(arr, mid + 1, right);
+  return NewNode(std::max(arena_[left_child].val, arena_[right_child].val),
+                 left_child, right_child);
+}
+
+uint32_t PersistentSegmentTree::Update(uint32_t node, size_t left,
+                                       size_t right, size_t pos,
+                                       long long val) {
+  if (left == right) {
+    return NewNode(val, cNoNode, cNoNode);
+  }
+  size_t mid = (left + right) / 2;
+  uint32_t left_child = arena_[node].left;
+  uint32_t right_child = arena_[node].right;
+  if (pos <= mid) {
+    left_child = Update(left_child, left, mid, pos, val);
+  } else {
+    right_child = Update(right_child, mid + 1, right, pos, val);
+  }
+  return NewNode(std::max(arena_[left_child].val, arena_[right_child].val),
+                 left_child, right_child);
+}
+
+long long PersistentSegmentTree::GetMax(uint32_t node, size_t left,
+                                        size_t right, size_t left_query,
+                                        size_t right_query) const {
+  if (right_query < left || left_query > right) {
+    return LLONG_MIN;
+  }
+  if (left_query <= left && right_query >= right) {
+    return arena_[node].val;
+  }
+  size_t mid = (left + right) / 2;
+  long long left_max =
+      GetMax(arena_[node].left, left, mid, left_query, right_query);
+  long long right_max =
+      GetMax(arena_[node].right, mid + 1, right, left_query, right_query);
+  return std::max(left_max, right_max);
+}
+
+uint32_t PersistentSegmentTree::CopyReachable(
+    uint32_t node, std::vector<Node>& new_arena,
+    std::vector<uint32_t>& remap) const {
+  if (node == cNoNode) {
+    return cNoNode;
+  }
+  if (remap[node] == cNoNode) {
+    uint32_t left = CopyReachable(arena_[node].left, new_arena, remap);
+    uint32_t right = CopyReachable(arena_[node].right, new_arena, remap);
+    new_arena.push_back({arena_[node].val, left, right});
+    remap[node] = new_arena.size() - 1;
+  }
+  return remap[node];
+}
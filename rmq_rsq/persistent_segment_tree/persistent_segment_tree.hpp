@@ -0,0 +1,78 @@
+/*
+How it works:
+A persistent segment tree keeps every version of the array that has ever
+existed. It has the same shape as the regular segment tree, but an update
+never modifies nodes in place: it copies the O(logn) nodes on the path from
+the root to the updated leaf and links the copies to the untouched subtrees of
+the previous version (path copying). Every version is therefore represented by
+its own root, and all versions share the unchanged nodes.
+
+Nodes are bump-allocated from one contiguous arena and refer to their
+children by 32-bit indices, so an update costs no heap allocations (amortized)
+and a node takes only 16 bytes. Old versions are reclaimed in bulk:
+ * Rollback(version) drops all versions newer than the given one. Their nodes
+   were allocated after every node of the kept versions, so the arena is just
+   truncated.
+ * DiscardBefore(version) drops all versions older than the given one by
+   copying the nodes reachable from the kept roots into a fresh arena.
+
+Versions are numbered in creation order, the initial array being version 0.
+
+Time Complexity: O(n) build, O(logn) for Update and GetMax of any version
+Memory Complexity: O(n) + O(logn) per update
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+class PersistentSegmentTree {
+ public:
+  PersistentSegmentTree(const std::vector<long long>& arr);
+
+  // Creates a new version from the given one and returns its number
+  size_t Update(size_t version, size_t pos, long long val);
+  size_t Update(size_t pos, long long val) {
+    return Update(LastVersion(), pos, val);
+  }
+
+  long long GetMax(size_t version, size_t left, size_t right) const {
+    return GetMax(roots_[version - first_version_], 0, size_ - 1, left,
+                  right);
+  }
+  long long GetMax(size_t left, size_t right) const {
+    return GetMax(LastVersion(), left, right);
+  }
+
+  size_t FirstVersion() const { return first_version_; }
+  size_t LastVersion() const { return first_version_ + roots_.size() - 1; }
+  size_t NodeCount() const { return arena_.size(); }
+
+  void Rollback(size_t version);
+  void DiscardBefore(size_t version);
+
+ private:
+  struct Node {
+    long long val;
+    uint32_t left;
+    uint32_t right;
+  };
+
+  static constexpr uint32_t cNoNode = UINT32_MAX;
+
+  std::vector<Node> arena_;
+  std::vector<uint32_t> roots_;
+  std::vector<size_t> arena_ends_;  // arena size right after each version
+  size_t first_version_ = 0;
+  size_t size_;
+
+  uint32_t NewNode(long long val, uint32_t left, uint32_t right);
+  uint32_t Build(const std::vector<long long>& arr, size_t left, size_t right);
+  uint32_t Update(uint32_t node, size_t left, size_t right, size_t pos,
+                  long long val);
+  long long GetMax(uint32_t node, size_t left, size_t right, size_t left_query,
+                   size_t right_query) const;
+  uint32_t CopyReachable(uint32_t node, std::vector<Node>& new_arena,
+                         std::vector<uint32_t>& remap) const;
+};
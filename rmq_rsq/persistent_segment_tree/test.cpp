@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "persistent_segment_tree.hpp"
+
+TEST(PersistentSegmentTreeTest, VersionsTest) {
+  std::vector<long long> arr{-100, 200, 70, -300, 0};
+  PersistentSegmentTree tree{arr};
+
+  size_t first = tree.Update(1, -50);  // -100 -50 70 -300 0
+  size_t second = tree.Update(3, 500);  // -100 -50 70 500 0
+  size_t branch = tree.Update(0, 2, 1000);  // -100 200 1000 -300 0
+
+  EXPECT_EQ(tree.GetMax(0, 0, 4), 200);
+  EXPECT_EQ(tree.GetMax(first, 0, 4), 70);
+  EXPECT_EQ(tree.GetMax(second, 0, 4), 500);
+  EXPECT_EQ(tree.GetMax(second, 0, 2), 70);
+  EXPECT_EQ(tree.GetMax(branch, 0, 4), 1000);
+  EXPECT_EQ(tree.GetMax(branch, 3, 4), 0);
+  EXPECT_EQ(tree.GetMax(0, 4), 1000);
+}
+
+TEST(PersistentSegmentTreeTest, ReclaimTest) {
+  std::vector<long long> arr{1, 2, 3, 4, 5, 6, 7, 8};
+  PersistentSegmentTree tree{arr};
+  size_t base_nodes = tree.NodeCount();
+
+  for (size_t i = 0; i < 8; ++i) {
+    tree.Update(i, 10 * (i + 1));
+  }
+  EXPECT_EQ(tree.GetMax(8, 0, 7), 80);
+
+  tree.Rollback(4);  // 10 20 30 40 5 6 7 8
+  EXPECT_EQ(tree.LastVersion(), 4);
+  EXPECT_EQ(tree.GetMax(0, 7), 40);
+  EXPECT_EQ(tree.GetMax(4, 7), 8);
+
+  tree.DiscardBefore(4);
+  EXPECT_EQ(tree.FirstVersion(), 4);
+  EXPECT_EQ(tree.NodeCount(), base_nodes);
+  EXPECT_EQ(tree.GetMax(4, 0, 7), 40);
+
+  size_t next = tree.Update(7, 100);
+  EXPECT_EQ(next, 5);
+  EXPECT_EQ(tree.GetMax(next, 0, 7), 100);
+  EXPECT_EQ(tree.GetMax(4, 0, 7), 40);
+}
+
+TEST(PersistentSegmentTreeTest, StressTest) {
+  const size_t N = 200;
+  const long long cMod = 1'000'000;
+  std::srand(std::time(nullptr));
+
+  std::vector<std::vector<long long>> versions(1, std::vector<long long>(N));
+  for (auto& elem : versions[0]) {
+    elem = std::rand() % cMod;
+  }
+  PersistentSegmentTree tree{versions[0]};
+
+  for (size_t i = 0; i < 2'000; ++i) {
+    size_t version = std::rand() % versions.size();
+    if (i % 2 == 0) {
+      size_t pos = std::rand() % N;
+      long long val = std::rand() % cMod;
+      versions.push_back(versions[version]);
+      versions.back()[pos] = val;
+      EXPECT_EQ(tree.Update(version, pos, val), versions.size() - 1);
+    } else {
+      size_t left = std::rand() % N;
+      size_t right = left + std::rand() % (N - left);
+      const auto& arr = versions[version];
+      EXPECT_EQ(tree.GetMax(version, left, right),
+                *std::max_element(arr.begin() + left,
+                                  arr.begin() + right + 1));
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
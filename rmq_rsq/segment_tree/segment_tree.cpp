@@ -1,25 +1,124 @@
 #include "segment_tree.hpp"
 
-SegmentTree::SegmentTree(const std::vector<long long>& arr) {
+SegmentTree::SegmentTree(const std::vector<long long>& arr,
+                         size_t num_threads) {
   size_ = arr.size();
   tree_.resize(4 * size_);
-  Build(arr, 0, size_ - 1, 1);
+  Build(arr, 0, size_ - 1, 1, num_threads);
 }
 
 void SegmentTree::Build(const std::vector<long long>& arr, size_t left,
-                        size_t right, size_t node) {
+                        size_t right, size_t node, size_t num_threads) {
   if (left == right) {
     tree_[node] = arr[left];
   } else {
     size_t mid = (left + right) / 2;
-    Build(arr, left, mid, node * 2);
-    Build(arr, mid + 1, right, node * 2 + 1);
+    if (num_threads > 1 && right - left + 1 >= cMinParallelWork) {
+      size_t left_threads = num_threads / 2;
+      std::thread left_builder(&SegmentTree::Build, this, std::cref(arr),
+                               left, mid, node * 2, left_threads);
+      Build(arr, mid + 1, right, node * 2 + 1, num_threads - left_threads);
+      left_builder.join();
+    } else {
+      Build(arr, left, mid, node * 2, 1);
+      Build(arr, mid + 1, right, node * 2 + 1, 1);
+    }
     tree_[node] = std::max(tree_[2 * node], tree_[2 * node + 1]);
   }
 }
 
+std::vector<long long> SegmentTree::GetMaxBatch(
+    const std::vector<std::pair<size_t, size_t>>& queries,
+    size_t num_threads) const {
+  std::vector<long long> answers(queries.size());
+  ParallelFor(queries.size(), num_threads, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      answers[i] = GetMax(queries[i].first, queries[i].second);
+    }
+  });
+  return answers;
+}
+
+void SegmentTree::UpdateBatch(
+    const std::vector<std::pair<size_t, long long>>& updates,
+    size_t num_threads) {
+  if (updates.empty()) {
+    return;
+  }
+  std::vector<size_t> leaves(updates.size());
+  ParallelFor(updates.size(), num_threads, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      leaves[i] = FindLeaf(updates[i].first);
+    }
+  });
+
+  for (size_t i = 0; i < updates.size(); ++i) {
+    tree_[leaves[i]] = updates[i].second;
+  }
+  // Nodes of level d have indices in [2^d, 2^(d+1)), so the sorted leaves are
+  // grouped by level, the deepest ones last
+  std::sort(leaves.begin(), leaves.end());
+  leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+
+  // Touched nodes of the current level in increasing order: the parents of the
+  // previous level plus the leaves of this one. Halving keeps the order, so
+  // the parents are deduplicated by comparing neighbours
+  std::vector<size_t> level;
+  std::vector<size_t> merged;
+  size_t leaves_end = leaves.size();
+  while (true) {
+    size_t depth = level.empty() ? Level(leaves[leaves_end - 1])
+                                 : Level(level[0]);
+    size_t leaves_begin = leaves_end;
+    while (leaves_begin > 0 && Level(leaves[leaves_begin - 1]) == depth) {
+      --leaves_begin;
+    }
+    if (leaves_begin != leaves_end) {
+      merged.clear();
+      std::merge(level.begin(), level.end(), leaves.begin() + leaves_begin,
+                 leaves.begin() + leaves_end, std::back_inserter(merged));
+      level.swap(merged);
+      leaves_end = leaves_begin;
+    }
+    if (depth == 0) {
+      break;
+    }
+
+    size_t parents = 0;
+    for (size_t node : level) {
+      if (parents == 0 || level[parents - 1] != node / 2) {
+        level[parents++] = node / 2;
+      }
+    }
+    level.resize(parents);
+    ParallelFor(level.size(), num_threads, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        size_t node = level[i];
+        tree_[node] = std::max(tree_[2 * node], tree_[2 * node + 1]);
+      }
+    });
+  }
+}
+
+size_t SegmentTree::FindLeaf(size_t pos) const {
+  size_t node = 1;
+  size_t left = 0;
+  size_t right = size_ - 1;
+  while (left != right) {
+    size_t mid = (left + right) / 2;
+    if (pos <= mid) {
+      node = 2 * node;
+      right = mid;
+    } else {
+      node = 2 * node + 1;
+      left = mid + 1;
+    }
+  }
+  return node;
+}
+
 long long SegmentTree::GetMax(size_t node, size_t left, size_t right,
-                              size_t left_query, size_t right_query) {
+                              size_t left_query, size_t right_query) const {
   if (right_query < left || left_query > right) {
     return LLONG_MIN;
   }
@@ -33,6 +132,22 @@ long long SegmentTree::GetMax(size_t node, size_t left, size_t right,
   return std::max(left_max, right_max);
 }
 
+size_t SegmentTree::FirstAtLeast(size_t node, size_t left, size_t right,
+                                 size_t left_query, long long val) const {
+  if (right < left_query || tree_[node] < val) {
+    return size_;
+  }
+  if (left == right) {
+    return left;
+  }
+  size_t mid = (left + right) / 2;
+  size_t res = FirstAtLeast(2 * node, left, mid, left_query, val);
+  if (res != size_) {
+    return res;
+  }
+  return FirstAtLeast(2 * node + 1, mid + 1, right, left_query, val);
+}
+
 void SegmentTree::Update(size_t node, size_t left, size_t right, size_t pos,
                          long long val) {
   if (left == right) {
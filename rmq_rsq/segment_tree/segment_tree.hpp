@@ -8,38 +8,100 @@ combining their results to compute the final answer. This design enables
 efficient range queries over the array while still supporting fast
 modifications.
 
-The following implementation supports two key operations in O(logn) time:
+The following implementation supports three key operations in O(logn) time:
 1) Finding the maximum element in a range (a[l...r]).
 2) Updating an element to a new value.
+3) Finding the first position in [l, n) whose value is >= x. Instead of a
+binary search over GetMax (O(log^2 n)), the tree is descended directly:
+subtrees whose maximum is below x are skipped as a whole.
 
 It is important to mention that memory complexity of the data structure still
 remains linear despite its power, not being greater than 4n in size.
+
+Offline workloads can be split across threads:
+ * Build: the two subtrees of a node are built by different threads
+ * GetMaxBatch: independent queries are distributed among threads
+ * UpdateBatch: the new values are written into the leaves, and then only the
+   touched ancestors are recalculated bottom-up, one tree level at a time
+   (nodes of the same level are independent, so each level is parallel).
+   The leaves are sorted once, and the touched nodes of every level are
+   derived from the previous level in order, without sorting again
 */
 
 #include <algorithm>
+#include <climits>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <utility>
 #include <vector>
 
 class SegmentTree {
  public:
-  SegmentTree(const std::vector<long long>& arr);
+  SegmentTree(const std::vector<long long>& arr, size_t num_threads = 1);
 
   void Update(size_t pos, long long val) { Update(1, 0, size_ - 1, pos, val); }
 
-  long long GetMax(size_t left, size_t right) {
+  long long GetMax(size_t left, size_t right) const {
     return GetMax(1, 0, size_ - 1, left, right);
   }
 
+  // Returns the size of the array if there is no such position
+  size_t FirstAtLeast(size_t left, long long val) const {
+    return FirstAtLeast(1, 0, size_ - 1, left, val);
+  }
+
+  std::vector<long long> GetMaxBatch(
+      const std::vector<std::pair<size_t, size_t>>& queries,
+      size_t num_threads = 1) const;
+
+  // Updates are applied in order, so the last one wins for repeated positions
+  void UpdateBatch(const std::vector<std::pair<size_t, long long>>& updates,
+                   size_t num_threads = 1);
+
  private:
   std::vector<long long> tree_;
   size_t size_;
 
+  // Splitting smaller jobs between threads costs more than it saves
+  static constexpr size_t cMinParallelWork = 1 << 12;
+
   void Build(const std::vector<long long>& arr, size_t left, size_t right,
-             size_t node);
+             size_t node, size_t num_threads);
 
   void Update(size_t node, size_t left, size_t right, size_t pos,
               long long val);
 
   long long GetMax(size_t node, size_t left, size_t right, size_t left_query,
-                   size_t right_query);
+                   size_t right_query) const;
+
+  size_t FirstAtLeast(size_t node, size_t left, size_t right,
+                      size_t left_query, long long val) const;
+
+  size_t FindLeaf(size_t pos) const;
+  static size_t Level(size_t node) { return 63 - __builtin_clzll(node); }
+
+  // Calls func(begin, end) on num_threads consecutive chunks of [0, count)
+  template <typename Func>
+  static void ParallelFor(size_t count, size_t num_threads, Func func);
 };
+
+template <typename Func>
+void SegmentTree::ParallelFor(size_t count, size_t num_threads, Func func) {
+  if (count < cMinParallelWork) {
+    num_threads = 1;
+  }
+  num_threads = std::max<size_t>(1, std::min(num_threads, count));
+  size_t chunk = (count + num_threads - 1) / num_threads;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(func, std::min(count, i * chunk),
+                         std::min(count, (i + 1) * chunk));
+  }
+  func(0, std::min(count, chunk));
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
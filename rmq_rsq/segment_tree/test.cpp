@@ -9,6 +9,101 @@ TEST(SegmentTreeTest, GetMaxSimpleTest) {
   EXPECT_EQ(tree.GetMax(-100, 100), 200);
 }
 
+TEST(SegmentTreeTest, FirstAtLeastTest) {
+  std::vector<long long> arr{3, 1, 4, 1, 5, 9, 2, 6};
+  SegmentTree tree{arr};
+  EXPECT_EQ(tree.FirstAtLeast(0, 4), 2);
+  EXPECT_EQ(tree.FirstAtLeast(3, 4), 4);
+  EXPECT_EQ(tree.FirstAtLeast(6, 3), 7);
+  EXPECT_EQ(tree.FirstAtLeast(0, 10), 8);
+
+  const long long cMod = 1'000;
+  std::srand(std::time(nullptr));
+  std::vector<long long> random(1'000);
+  for (auto& elem : random) {
+    elem = std::rand() % cMod;
+  }
+  SegmentTree random_tree{random};
+  for (size_t i = 0; i < 1'000; ++i) {
+    size_t left = std::rand() % random.size();
+    long long val = std::rand() % cMod;
+    size_t expected = left;
+    while (expected < random.size() && random[expected] < val) {
+      ++expected;
+    }
+    EXPECT_EQ(random_tree.FirstAtLeast(left, val), expected);
+  }
+}
+
+TEST(SegmentTreeTest, BatchTest) {
+  const size_t N = 100'000;
+  const long long cMod = 1'000'000;
+  std::srand(std::time(nullptr));
+
+  std::vector<long long> arr(N);
+  for (auto& elem : arr) {
+    elem = std::rand() % cMod;
+  }
+  SegmentTree tree{arr, 4};
+
+  std::vector<std::pair<size_t, long long>> updates;
+  for (size_t i = 0; i < 20'000; ++i) {
+    updates.emplace_back(std::rand() % N, std::rand() % cMod);
+    arr[updates.back().first] = updates.back().second;
+  }
+  tree.UpdateBatch(updates, 4);
+
+  std::vector<std::pair<size_t, size_t>> queries;
+  for (size_t i = 0; i < 10'000; ++i) {
+    size_t left = std::rand() % N;
+    queries.emplace_back(left, left + std::rand() % std::min<size_t>(
+                                          N - left, 1000));
+  }
+  std::vector<long long> answers = tree.GetMaxBatch(queries, 4);
+
+  for (size_t i = 0; i < queries.size(); ++i) {
+    auto [left, right] = queries[i];
+    EXPECT_EQ(answers[i], *std::max_element(arr.begin() + left,
+                                            arr.begin() + right + 1));
+    EXPECT_EQ(answers[i], tree.GetMax(left, right));
+  }
+}
+
+TEST(SegmentTreeTest, UpdateBatchMatchesUpdateTest) {
+  std::srand(std::time(nullptr));
+  for (size_t n : {1, 2, 3, 7, 1'000, 100'003}) {
+    for (size_t num_threads : {1, 4}) {
+      std::vector<long long> arr(n);
+      for (auto& elem : arr) {
+        elem = std::rand() % 1'000;
+      }
+      SegmentTree batched(arr);
+      SegmentTree looped(arr);
+
+      // Few distinct positions, so repeated updates of a leaf are common
+      std::vector<std::pair<size_t, long long>> updates;
+      for (size_t i = 0; i < 3 * n; ++i) {
+        updates.emplace_back(std::rand() % n, std::rand() % 1'000);
+      }
+      batched.UpdateBatch(updates, num_threads);
+      batched.UpdateBatch({}, num_threads);
+      for (auto [pos, val] : updates) {
+        looped.Update(pos, val);
+      }
+
+      for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(batched.GetMax(i, i), looped.GetMax(i, i));
+      }
+      for (size_t i = 0; i < 1'000; ++i) {
+        size_t left = std::rand() % n;
+        size_t right = left + std::rand() % (n - left);
+        EXPECT_EQ(batched.GetMax(left, right), looped.GetMax(left, right));
+      }
+      EXPECT_EQ(batched.GetMax(0, n - 1), looped.GetMax(0, n - 1));
+    }
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
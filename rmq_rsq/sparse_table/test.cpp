@@ -2,6 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <type_traits>
+
 TEST(SparseTableTest, Test) {
   std::vector<long long> arr{-100, 200, 70, -300, 0};
   SparseTable st(arr);
@@ -9,6 +14,145 @@ TEST(SparseTableTest, Test) {
   EXPECT_EQ(st.PreminQuery(0, 2), 70);
 }
 
+TEST(SparseTableTest, StressTest) {
+  const size_t N = 300;
+  std::srand(std::time(nullptr));
+
+  std::vector<long long> arr(N);
+  std::iota(arr.begin(), arr.end(), -150);
+  std::shuffle(arr.begin(), arr.end(), std::mt19937(std::rand()));
+  SparseTable st(arr);
+
+  for (size_t i = 0; i < 5'000; ++i) {
+    size_t l = std::rand() % (N - 1);
+    size_t r = l + 1 + std::rand() % (N - l - 1);
+    std::vector<long long> segment(arr.begin() + l, arr.begin() + r + 1);
+    std::sort(segment.begin(), segment.end());
+    EXPECT_EQ(st.MinQuery(l, r), segment[0]);
+    EXPECT_EQ(st.PreminQuery(l, r), segment[1]);
+  }
+}
+
+TEST(SparseTableTest, DuplicatesTest) {
+  std::vector<long long> arr{1, 1, 5, 3, 3, 3};
+  SparseTable st(arr);
+  EXPECT_EQ(st.PreminQuery(0, 1), 1);
+  EXPECT_EQ(st.PreminQuery(0, 2), 1);
+  EXPECT_EQ(st.PreminQuery(1, 3), 3);
+  EXPECT_EQ(st.PreminQuery(3, 5), 3);
+  EXPECT_EQ(st.MinQuery(2, 5), 3);
+}
+
+TEST(SparseTableTest, ParallelBuildTest) {
+  const size_t N = 200'000;
+  std::vector<long long> arr(N);
+  for (auto& elem : arr) {
+    elem = std::rand() % 1'000;
+  }
+  SparseTable serial(arr);
+  SparseTable parallel(arr, 4);
+
+  for (size_t i = 0; i < 10'000; ++i) {
+    size_t l = std::rand() % (N - 1);
+    size_t r = l + 1 + std::rand() % (N - l - 1);
+    EXPECT_EQ(parallel.MinQuery(l, r), serial.MinQuery(l, r));
+    EXPECT_EQ(parallel.PreminQuery(l, r), serial.PreminQuery(l, r));
+  }
+  for (size_t i = 0; i < 1'000; ++i) {
+    size_t l = std::rand() % (N - 1);
+    size_t r = l + 1 + std::rand() % std::min<size_t>(N - l - 1, 100);
+    std::vector<long long> segment(arr.begin() + l, arr.begin() + r + 1);
+    std::sort(segment.begin(), segment.end());
+    EXPECT_EQ(parallel.PreminQuery(l, r), segment[1]);
+  }
+}
+
+template <typename Table, typename = void>
+struct HasPremin : std::false_type {};
+
+template <typename Table>
+struct HasPremin<Table, std::void_t<decltype(std::declval<Table>().PreminQuery(
+                            0, 0))>> : std::true_type {};
+
+static_assert(HasPremin<SparseTable<>>::value);
+static_assert(HasPremin<SparseTable<MaxMonoid<double>, true>>::value);
+static_assert(!HasPremin<SparseTable<MinMonoid<uint32_t>>>::value);
+static_assert(!HasPremin<SparseTable<GcdMonoid<uint32_t>>>::value);
+static_assert(!HasPremin<SparseTable<AndMonoid<uint32_t>>>::value);
+static_assert(
+    std::is_same_v<SparseTable<MaxMonoid<double>>::Value, double>);
+
+TEST(SparseTableTest, GenericOperationsTest) {
+  std::vector<uint32_t> bits{0b1100, 0b1010, 0b0110, 0b1111};
+  SparseTable<AndMonoid<uint32_t>> and_table(bits);
+  SparseTable<OrMonoid<uint32_t>> or_table(bits);
+  EXPECT_EQ(and_table.Query(0, 1), 0b1000);
+  EXPECT_EQ(and_table.Query(0, 3), 0b0000);
+  EXPECT_EQ(or_table.Query(1, 2), 0b1110);
+
+  std::vector<uint32_t> nums{12, 18, 6, 9, 30};
+  SparseTable<GcdMonoid<uint32_t>> gcd(nums);
+  EXPECT_EQ(gcd.Query(0, 1), 6);
+  EXPECT_EQ(gcd.Query(2, 4), 3);
+
+  std::vector<double> reals{0.5, -1.25, 3.75, 2.0};
+  SparseTable<MaxMonoid<double>, true> max(reals);
+  EXPECT_DOUBLE_EQ(max.Query(0, 3), 3.75);
+  EXPECT_DOUBLE_EQ(max.PreminQuery(0, 3), 2.0);
+  EXPECT_DOUBLE_EQ(max.PreminQuery(0, 1), -1.25);
+}
+
+TEST(SparseTableTest, GenericStressTest) {
+  const size_t N = 300;
+  std::vector<uint32_t> arr(N);
+  for (auto& elem : arr) {
+    elem = std::rand();
+  }
+  SparseTable<OrMonoid<uint32_t>> or_table(arr);
+  SparseTable<MaxMonoid<uint32_t>, true> max_table(arr);
+
+  for (size_t i = 0; i < 2'000; ++i) {
+    size_t l = std::rand() % (N - 1);
+    size_t r = l + 1 + std::rand() % (N - l - 1);
+    uint32_t expected = 0;
+    for (size_t k = l; k <= r; ++k) {
+      expected |= arr[k];
+    }
+    EXPECT_EQ(or_table.Query(l, r), expected);
+
+    std::vector<uint32_t> segment(arr.begin() + l, arr.begin() + r + 1);
+    std::sort(segment.rbegin(), segment.rend());
+    EXPECT_EQ(max_table.Query(l, r), segment[0]);
+    EXPECT_EQ(max_table.PreminQuery(l, r), segment[1]);
+  }
+}
+
+TEST(SparseTableTest, BatchQueryTest) {
+  const size_t N = 100'000;
+  std::vector<long long> arr(N);
+  for (auto& elem : arr) {
+    elem = std::rand() % 1'000;
+  }
+  SparseTable st(arr);
+  SparseTable<MaxMonoid<long long>> max_table(arr);
+
+  std::vector<std::pair<long long, long long>> queries;
+  for (size_t i = 0; i < 10'007; ++i) {
+    size_t l = std::rand() % (N - 1);
+    queries.emplace_back(l, l + 1 + std::rand() % (N - l - 1));
+  }
+  std::vector<long long> mins = st.QueryBatch(queries);
+  std::vector<long long> premins = st.PreminQueryBatch(queries);
+  std::vector<long long> maxs = max_table.QueryBatch(queries);
+
+  for (size_t i = 0; i < queries.size(); ++i) {
+    auto [l, r] = queries[i];
+    EXPECT_EQ(mins[i], st.MinQuery(l, r));
+    EXPECT_EQ(premins[i], st.PreminQuery(l, r));
+    EXPECT_EQ(maxs[i], max_table.Query(l, r));
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
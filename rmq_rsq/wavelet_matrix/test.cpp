@@ -0,0 +1,51 @@
+#include "wavelet_matrix.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(WaveletMatrixTest, Test) {
+  std::vector<long long> arr{-100, 200, 70, -300, 0};
+  WaveletMatrix wm(arr);
+  EXPECT_EQ(wm.KthSmallest(0, 2, 0), -100);
+  EXPECT_EQ(wm.KthSmallest(0, 2, 1), 70);
+  EXPECT_EQ(wm.KthSmallest(0, 4, 4), 200);
+  EXPECT_EQ(wm.KthSmallest(1, 4, 1), 0);
+
+  EXPECT_EQ(wm.CountLess(0, 4, 0), 2);
+  EXPECT_EQ(wm.CountLess(0, 4, 1), 3);
+  EXPECT_EQ(wm.CountLess(1, 2, -1'000), 0);
+  EXPECT_EQ(wm.CountLess(1, 2, 1'000), 2);
+}
+
+TEST(WaveletMatrixTest, StressTest) {
+  std::srand(std::time(nullptr));
+  for (size_t n : {1, 2, 64, 65, 300}) {
+    for (long long mod : {1, 2, 16, 1'000'000}) {
+      std::vector<long long> arr(n);
+      for (auto& elem : arr) {
+        elem = std::rand() % mod - mod / 2;
+      }
+      WaveletMatrix wm(arr);
+
+      for (size_t i = 0; i < 300; ++i) {
+        size_t l = std::rand() % n;
+        size_t r = l + std::rand() % (n - l);
+        std::vector<long long> segment(arr.begin() + l, arr.begin() + r + 1);
+        std::sort(segment.begin(), segment.end());
+
+        size_t k = std::rand() % segment.size();
+        EXPECT_EQ(wm.KthSmallest(l, r, k), segment[k]);
+
+        long long x = std::rand() % (mod + 2) - mod / 2 - 1;
+        size_t expected =
+            std::lower_bound(segment.begin(), segment.end(), x) -
+            segment.begin();
+        EXPECT_EQ(wm.CountLess(l, r, x), expected);
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+#include "wavelet_matrix.hpp"
+
+void WaveletMatrix::BitVector::BuildRanks() {
+  for (size_t i = 1; i < words_.size(); ++i) {
+    ranks_[i] = ranks_[i - 1] + __builtin_popcountll(words_[i - 1]);
+  }
+}
+
+WaveletMatrix::WaveletMatrix(const std::vector<long long>& arr)
+    : sorted_values_(arr), num_bits_(1) {
+  std::sort(sorted_values_.begin(), sorted_values_.end());
+  sorted_values_.erase(
+      std::unique(sorted_values_.begin(), sorted_values_.end()),
+      sorted_values_.end());
+  while ((size_t{1} << num_bits_) < sorted_values_.size()) {
+    ++num_bits_;
+  }
+
+  std::vector<uint32_t> codes(arr.size());
+  for (size_t i = 0; i < arr.size(); ++i) {
+    codes[i] = std::lower_bound(sorted_values_.begin(), sorted_values_.end(),
+                                arr[i]) -
+               sorted_values_.begin();
+  }
+
+  std::vector<uint32_t> zero_side;
+  std::vector<uint32_t> one_side;
+  for (size_t level = 0; level < num_bits_; ++level) {
+    size_t bit = num_bits_ - 1 - level;
+    levels_.emplace_back(codes.size());
+    zero_side.clear();
+    one_side.clear();
+    for (size_t i = 0; i < codes.size(); ++i) {
+      if ((codes[i] >> bit) & 1) {
+        levels_.back().Set(i);
+        one_side.push_back(codes[i]);
+      } else {
+        zero_side.push_back(codes[i]);
+      }
+    }
+    levels_.back().BuildRanks();
+    zeros_.push_back(zero_side.size());
+
+    std::copy(zero_side.begin(), zero_side.end(), codes.begin());
+    std::copy(one_side.begin(), one_side.end(),
+              codes.begin() + zero_side.size());
+  }
+}
+
+long long WaveletMatrix::KthSmallest(size_t l, size_t r, size_t k) const {
+  size_t left = l;
+  size_t right = r + 1;
+  size_t code = 0;
+  for (size_t level = 0; level < num_bits_; ++level) {
+    const BitVector& bits = levels_[level];
+    size_t left_zeros = bits.Rank0(left);
+    size_t right_zeros = bits.Rank0(right);
+    if (k < right_zeros - left_zeros) {
+      left = left_zeros;
+      right = right_zeros;
+    } else {
+      k -= right_zeros - left_zeros;
+      code |= size_t{1} << (num_bits_ - 1 - level);
+      left = zeros_[level] + (left - left_zeros);
+      right = zeros_[level] + (right - right_zeros);
+    }
+  }
+  return sorted_values_[code];
+}
+
+size_t WaveletMatrix::CountLess(size_t l, size_t r, long long x) const {
+  size_t code = std::lower_bound(sorted_values_.begin(), sorted_values_.end(),
+                                 x) -
+                sorted_values_.begin();
+  if (code >> num_bits_ != 0) {
+    return r - l + 1;
+  }
+
+  size_t left = l;
+  size_t right = r + 1;
+  size_t count = 0;
+  for (size_t level = 0; level < num_bits_; ++level) {
+    const BitVector& bits = levels_[level];
+    size_t left_zeros = bits.Rank0(left);
+    size_t right_zeros = bits.Rank0(right);
+    if ((code >> (num_bits_ - 1 - level)) & 1) {
+      count += right_zeros - left_zeros;
+      left = zeros_[level] + (left - left_zeros);
+      right = zeros_[level] + (right - right_zeros);
+    } else {
+      left = left_zeros;
+      right = right_zeros;
+    }
+  }
+  return count;
+}
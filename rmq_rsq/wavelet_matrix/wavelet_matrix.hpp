@@ -0,0 +1,66 @@
+/*
+How it works:
+A wavelet matrix answers order-statistic queries on arbitrary subarrays,
+which a sparse table cannot do beyond the first two statistics.
+
+The values are first compressed to codes 0...σ-1 (σ is the number of distinct
+values), each code having B = ceil(log2 σ) bits. Level 0 stores the highest
+bit of every code in array order; then the sequence is stably partitioned
+(codes with a 0 bit first, those with a 1 bit after them), and level 1 stores
+the next bit of the reordered sequence, and so on down to the lowest bit.
+
+Any subarray [l, r) of a level maps to a contiguous subarray of the next one:
+its elements with a 0 bit go to [rank0(l), rank0(r)) and those with a 1 bit
+go to [zeros + rank1(l), zeros + rank1(r)). Hence a query walks down the B
+levels choosing one side at each of them:
+ * KthSmallest(l, r, k): go to the zero side if it holds more than k elements,
+   otherwise skip its elements and go to the one side.
+ * CountLess(l, r, x): follow the bits of x's code, adding the size of the
+   zero side every time the code goes to the one side.
+
+Each level is a bit vector with rank support: 64-bit words plus the number of
+ones before every word, so rank is one lookup and one popcount.
+
+Time Complexity: O(nlogσ) build + O(logσ) for each query
+Memory Complexity: O(nlogσ) bits + O(n) for the compressed values
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class WaveletMatrix {
+ public:
+  WaveletMatrix(const std::vector<long long>& arr);
+
+  // k-th smallest (0-indexed) value in a[l...r]
+  long long KthSmallest(size_t l, size_t r, size_t k) const;
+
+  // Number of values less than x in a[l...r]
+  size_t CountLess(size_t l, size_t r, long long x) const;
+
+ private:
+  class BitVector {
+   public:
+    BitVector(size_t size) : words_(size / 64 + 1), ranks_(size / 64 + 1) {}
+
+    void Set(size_t pos) { words_[pos / 64] |= uint64_t{1} << (pos % 64); }
+    void BuildRanks();
+
+    // Number of ones among the first pos bits
+    size_t Rank1(size_t pos) const {
+      uint64_t mask = (uint64_t{1} << (pos % 64)) - 1;
+      return ranks_[pos / 64] + __builtin_popcountll(words_[pos / 64] & mask);
+    }
+    size_t Rank0(size_t pos) const { return pos - Rank1(pos); }
+
+   private:
+    std::vector<uint64_t> words_;
+    std::vector<uint32_t> ranks_;  // ones before every word
+  };
+
+  std::vector<long long> sorted_values_;
+  size_t num_bits_;
+  std::vector<BitVector> levels_;
+  std::vector<size_t> zeros_;  // number of zero bits on every level
+};
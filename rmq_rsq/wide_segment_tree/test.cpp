@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "wide_segment_tree.hpp"
+
+TEST(WideSegmentTreeTest, GetMaxSimpleTest) {
+  std::vector<long long> arr{-100, 200, 70, -300, 0};
+  WideSegmentTree tree{arr};
+  EXPECT_EQ(tree.GetMax(0, 4), 200);
+  EXPECT_EQ(tree.GetMax(2, 4), 70);
+  EXPECT_EQ(tree.GetMax(4, 5), 0);
+
+  tree.Update(3, 500);
+  EXPECT_EQ(tree.GetMax(2, 4), 500);
+}
+
+TEST(WideSegmentTreeTest, StressTest) {
+  std::srand(std::time(nullptr));
+  const long long cMod = 1'000'000;
+
+  for (size_t n : {1, 7, 8, 9, 64, 65, 513, 5000}) {
+    std::vector<long long> arr(n);
+    for (auto& elem : arr) {
+      elem = std::rand() % cMod - cMod / 2;
+    }
+    WideSegmentTree tree{arr};
+
+    for (size_t i = 0; i < 5'000; ++i) {
+      if (i % 2 == 0) {
+        size_t pos = std::rand() % n;
+        arr[pos] = std::rand() % cMod - cMod / 2;
+        tree.Update(pos, arr[pos]);
+      } else {
+        size_t left = std::rand() % n;
+        size_t right = left + std::rand() % (n - left);
+        EXPECT_EQ(tree.GetMax(left, right),
+                  *std::max_element(arr.begin() + left,
+                                    arr.begin() + right + 1));
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
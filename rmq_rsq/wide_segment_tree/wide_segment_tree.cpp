@@ -0,0 +1,74 @@
+#include "wide_segment_tree.hpp"
+
+WideSegmentTree::WideSegmentTree(const std::vector<long long>& arr)
+    : size_(arr.size()) {
+  size_t total_blocks = 0;
+  size_t len = size_;
+  do {
+    level_offsets_.push_back(total_blocks);
+    len = BlockCount(len);
+    total_blocks += len;
+  } while (len > 1);
+  blocks_.resize(total_blocks);
+
+  for (Block& block : blocks_) {
+    std::fill(block.vals, block.vals + cBlockSize, LLONG_MIN);
+  }
+  for (size_t i = 0; i < size_; ++i) {
+    At(0, i) = arr[i];
+  }
+  for (size_t level = 1; level < level_offsets_.size(); ++level) {
+    for (size_t i = level_offsets_[level - 1]; i < level_offsets_[level];
+         ++i) {
+      At(level, i - level_offsets_[level - 1]) = BlockMax(blocks_[i]);
+    }
+  }
+}
+
+void WideSegmentTree::Update(size_t pos, long long val) {
+  At(0, pos) = val;
+  for (size_t level = 1; level < level_offsets_.size(); ++level) {
+    pos /= cBlockSize;
+    At(level, pos) = BlockMax(blocks_[level_offsets_[level - 1] + pos]);
+  }
+}
+
+long long WideSegmentTree::GetMax(size_t left, size_t right) const {
+  right = std::min(right, size_ - 1);
+  long long res = LLONG_MIN;
+  for (size_t level = 0; left <= right; ++level) {
+    size_t left_block = left / cBlockSize;
+    size_t right_block = right / cBlockSize;
+    if (left_block == right_block) {
+      return std::max(res, RangeMax(level, left, right));
+    }
+    res = std::max(res,
+                   RangeMax(level, left, (left_block + 1) * cBlockSize - 1));
+    res = std::max(res, RangeMax(level, right_block * cBlockSize, right));
+    left = left_block + 1;
+    right = right_block - 1;
+  }
+  return res;
+}
+
+long long WideSegmentTree::RangeMax(size_t level, size_t left,
+                                    size_t right) const {
+  const Block& block = blocks_[level_offsets_[level] + left / cBlockSize];
+  size_t lo = left % cBlockSize;
+  size_t len = right % cBlockSize - lo;
+  long long res = LLONG_MIN;
+  for (size_t i = 0; i < cBlockSize; ++i) {
+    // All ones inside [lo, lo + len], the unsigned wrap rejects i < lo
+    long long mask = -static_cast<long long>(i - lo <= len);
+    res = std::max(res, (block.vals[i] & mask) | (LLONG_MIN & ~mask));
+  }
+  return res;
+}
+
+long long WideSegmentTree::BlockMax(const Block& block) {
+  long long res = block.vals[0];
+  for (size_t i = 1; i < cBlockSize; ++i) {
+    res = std::max(res, block.vals[i]);
+  }
+  return res;
+}
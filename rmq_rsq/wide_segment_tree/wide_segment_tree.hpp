@@ -0,0 +1,63 @@
+/*
+How it works:
+A wide (B-ary) segment tree is a cache-friendly variation of the segment tree
+for large arrays. Every node has B = 8 children instead of two, and the
+children of a node are stored next to each other in one cache-line-aligned
+block of eight long longs:
+- level 0 holds the array itself, padded to a multiple of B;
+- element j of level h+1 is the maximum of block j of level h.
+
+A root-to-leaf walk of the binary tree touches about log2(n) scattered cache
+lines, whereas here every level touches at most two blocks and there are only
+log8(n) levels. Maximums inside a block are computed with a plain loop over a
+contiguous aligned array, which the compiler turns into SIMD code. The partial
+blocks at the ends of a query are scanned the same way over the whole block,
+with the cells outside the query masked to LLONG_MIN.
+
+The following implementation supports two key operations in O(B * log_B(n))
+time, i.e. O(logn) with a much smaller number of cache misses:
+1) Finding the maximum element in a range (a[l...r]).
+2) Updating an element to a new value.
+
+The memory complexity is about n * B / (B - 1) elements.
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+class WideSegmentTree {
+ public:
+  static constexpr size_t cBlockSize = 8;
+
+  WideSegmentTree(const std::vector<long long>& arr);
+
+  void Update(size_t pos, long long val);
+  long long GetMax(size_t left, size_t right) const;
+
+ private:
+  struct alignas(64) Block {
+    long long vals[cBlockSize];
+  };
+
+  size_t size_;
+  std::vector<Block> blocks_;
+  std::vector<size_t> level_offsets_;  // first block of each level
+
+  long long& At(size_t level, size_t idx) {
+    return blocks_[level_offsets_[level] + idx / cBlockSize]
+        .vals[idx % cBlockSize];
+  }
+  long long At(size_t level, size_t idx) const {
+    return blocks_[level_offsets_[level] + idx / cBlockSize]
+        .vals[idx % cBlockSize];
+  }
+
+  // left and right must lie in the same block
+  long long RangeMax(size_t level, size_t left, size_t right) const;
+  static long long BlockMax(const Block& block);
+  static size_t BlockCount(size_t len) {
+    return (len + cBlockSize - 1) / cBlockSize;
+  }
+};
@@ -1,5 +1,22 @@
 #include "avl_tree.hpp"
 
+#include <future>
+
+AVLTree::AVLTree(const std::vector<Long>& sorted) {
+  std::vector<Long> unique(sorted);
+  unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+  root_ = Build(unique, 0, unique.size());
+}
+
+AVLTree& AVLTree::operator=(AVLTree&& other) {
+  if (this != &other) {
+    RemoveNode(root_);
+    root_ = other.root_;
+    other.root_ = nullptr;
+  }
+  return *this;
+}
+
 Long AVLTree::LowerBound(Long val) {
   const Node* result = LowerBound(root_, val);
   if (result == nullptr) {
@@ -8,6 +25,114 @@ Long AVLTree::LowerBound(Long val) {
   return result->val;
 }
 
+std::optional<Long> AVLTree::Kth(Long k) const {
+  if (k < 0 || k >= Size()) {
+    return std::nullopt;
+  }
+  const Node* node = root_;
+  while (true) {
+    Long left_size = Size(node->left);
+    if (k == left_size) {
+      return node->val;
+    }
+    if (k < left_size) {
+      node = node->left;
+    } else {
+      k -= left_size + 1;
+      node = node->right;
+    }
+  }
+}
+
+Long AVLTree::Rank(Long val) const {
+  Long rank = 0;
+  const Node* node = root_;
+  while (node != nullptr) {
+    if (node->val < val) {
+      rank += Size(node->left) + 1;
+      node = node->right;
+    } else {
+      node = node->left;
+    }
+  }
+  return rank;
+}
+
+Long AVLTree::RangeCount(Long l, Long r) const {
+  if (l > r) {
+    return 0;
+  }
+  if (r == LLONG_MAX) {
+    return Size() - Rank(l);
+  }
+  return Rank(r + 1) - Rank(l);
+}
+
+void AVLTree::Iterator::PushLeftPath(const Node* node) {
+  while (node != nullptr) {
+    stack_.push_back(node);
+    node = node->left;
+  }
+}
+
+AVLTree::Iterator& AVLTree::Iterator::operator++() {
+  const Node* node = stack_.back();
+  stack_.pop_back();
+  PushLeftPath(node->right);
+  return *this;
+}
+
+AVLTree::Iterator AVLTree::begin() const {
+  Iterator it;
+  it.PushLeftPath(root_);
+  return it;
+}
+
+// The stack holds the nodes where the search went left: exactly the
+// ancestors not yet visited by an in-order scan starting at the lower bound
+AVLTree::Iterator AVLTree::IteratorFrom(Long val) const {
+  Iterator it;
+  const Node* node = root_;
+  while (node != nullptr) {
+    if (node->val >= val) {
+      it.stack_.push_back(node);
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  return it;
+}
+
+AVLTree AVLTree::Split(Long key) {
+  Node* left = nullptr;
+  Node* equal = nullptr;
+  Node* right = nullptr;
+  Split(root_, key, left, equal, right);
+  root_ = left;
+
+  AVLTree result;
+  result.root_ = equal == nullptr ? right : Join(nullptr, equal, right);
+  return result;
+}
+
+void AVLTree::Join(AVLTree&& other) {
+  Node* min = nullptr;
+  Node* rest = other.root_;
+  other.root_ = nullptr;
+  if (rest == nullptr) {
+    return;
+  }
+  rest = RemoveMin(rest, min);
+  root_ = Join(root_, min, rest);
+}
+
+void AVLTree::Union(AVLTree&& other, size_t num_threads) {
+  root_ = Union(root_, other.root_, std::max<size_t>(num_threads, 1));
+  other.root_ = nullptr;
+}
+
+// Also recomputes the subtree size
 void AVLTree::UpdateHeight(Node* node) {
   size_t hleft = 0;
   size_t hright = 0;
@@ -18,6 +143,7 @@ void AVLTree::UpdateHeight(Node* node) {
     hright = node->right->height;
   }
   node->height = std::max(hleft, hright) + 1;
+  node->size = Size(node->left) + Size(node->right) + 1;
 }
 
 AVLTree::Node* AVLTree::LeftRotation(Node* node) {
@@ -74,6 +200,143 @@ AVLTree::Node* AVLTree::Rebalance(Node* node) {
   return node;
 }
 
+Long AVLTree::Height(const Node* node) {
+  return node == nullptr ? 0 : node->height;
+}
+
+Long AVLTree::Size(const Node* node) {
+  return node == nullptr ? 0 : node->size;
+}
+
+AVLTree::Node* AVLTree::Build(const std::vector<Long>& sorted, size_t begin,
+                              size_t end) {
+  if (begin == end) {
+    return nullptr;
+  }
+  size_t mid = begin + (end - begin) / 2;
+  Node* node = new Node(sorted[mid]);
+  node->left = Build(sorted, begin, mid);
+  node->right = Build(sorted, mid + 1, end);
+  UpdateHeight(node);
+  return node;
+}
+
+AVLTree::Node* AVLTree::Join(Node* left, Node* mid, Node* right) {
+  if (Height(left) > Height(right) + 1) {
+    return JoinRight(left, mid, right);
+  }
+  if (Height(right) > Height(left) + 1) {
+    return JoinLeft(left, mid, right);
+  }
+  mid->left = left;
+  mid->right = right;
+  UpdateHeight(mid);
+  return mid;
+}
+
+// left is the taller tree: descend its right spine
+AVLTree::Node* AVLTree::JoinRight(Node* left, Node* mid, Node* right) {
+  if (Height(left->right) <= Height(right) + 1) {
+    mid->left = left->right;
+    mid->right = right;
+    UpdateHeight(mid);
+    left->right = mid;
+  } else {
+    left->right = JoinRight(left->right, mid, right);
+  }
+  return Rebalance(left);
+}
+
+// right is the taller tree: descend its left spine
+AVLTree::Node* AVLTree::JoinLeft(Node* left, Node* mid, Node* right) {
+  if (Height(right->left) <= Height(left) + 1) {
+    mid->left = left;
+    mid->right = right->left;
+    UpdateHeight(mid);
+    right->left = mid;
+  } else {
+    right->left = JoinLeft(left, mid, right->left);
+  }
+  return Rebalance(right);
+}
+
+AVLTree::Node* AVLTree::RemoveMin(Node* node, Node*& min) {
+  if (node->left == nullptr) {
+    Node* right = node->right;
+    min = node;
+    min->right = nullptr;
+    UpdateHeight(min);
+    return right;
+  }
+  node->left = RemoveMin(node->left, min);
+  return Rebalance(node);
+}
+
+// Splits into the elements < key, the node equal to key (or nullptr) and the
+// elements > key
+void AVLTree::Split(Node* node, Long key, Node*& left, Node*& equal,
+                    Node*& right) {
+  if (node == nullptr) {
+    left = nullptr;
+    equal = nullptr;
+    right = nullptr;
+    return;
+  }
+  Node* node_left = node->left;
+  Node* node_right = node->right;
+  node->left = nullptr;
+  node->right = nullptr;
+  UpdateHeight(node);
+
+  if (key == node->val) {
+    left = node_left;
+    equal = node;
+    right = node_right;
+  } else if (key < node->val) {
+    Split(node_left, key, left, equal, right);
+    right = Join(right, node, node_right);
+  } else {
+    Split(node_right, key, left, equal, right);
+    left = Join(node_left, node, left);
+  }
+}
+
+AVLTree::Node* AVLTree::Union(Node* first, Node* second,
+                              size_t num_threads) {
+  if (first == nullptr) {
+    return second;
+  }
+  if (second == nullptr) {
+    return first;
+  }
+  Node* first_left = first->left;
+  Node* first_right = first->right;
+  first->left = nullptr;
+  first->right = nullptr;
+
+  Node* second_left = nullptr;
+  Node* duplicate = nullptr;
+  Node* second_right = nullptr;
+  Split(second, first->val, second_left, duplicate, second_right);
+  delete duplicate;
+
+  Node* left = nullptr;
+  Node* right = nullptr;
+  if (num_threads > 1) {
+    size_t left_threads = num_threads / 2;
+    std::future<Node*> left_future =
+        std::async(std::launch::async, [&]() {
+          return Union(first_left, second_left, left_threads);
+        });
+    right = Union(first_right, second_right, num_threads - left_threads);
+    left = left_future.get();
+  } else {
+    left = Union(first_left, second_left, 1);
+    right = Union(first_right, second_right, 1);
+  }
+  return Join(left, first, right);
+}
+
 AVLTree::Node* AVLTree::Insert(Node* node, Long val) {
   if (node == nullptr) {
     return new Node(val);
@@ -89,6 +352,31 @@ AVLTree::Node* AVLTree::Insert(Node* node, Long val) {
   return Rebalance(node);
 }
 
+AVLTree::Node* AVLTree::Erase(Node* node, Long val) {
+  if (node == nullptr) {
+    return nullptr;
+  }
+  if (val < node->val) {
+    node->left = Erase(node->left, val);
+  } else if (val > node->val) {
+    node->right = Erase(node->right, val);
+  } else {
+    Node* left = node->left;
+    Node* right = node->right;
+    delete node;
+    if (right == nullptr) {
+      return left;
+    }
+    // The minimum of the right subtree takes the place of the erased node
+    Node* min = nullptr;
+    right = RemoveMin(right, min);
+    min->left = left;
+    min->right = right;
+    node = min;
+  }
+  return Rebalance(node);
+}
+
 const AVLTree::Node* AVLTree::LowerBound(const Node* node, Long val) const {
   if (node == nullptr) {
     return nullptr;
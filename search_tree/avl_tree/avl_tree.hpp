@@ -8,34 +8,127 @@ node's value.
 at most 1. The balance is maintained through tree rotations after insertions.
 
 The last invariant is maintained by performing left and right rotations after
-insertions.
+insertions and erasures.
 
-It supports inserting elements and getting lower bound of an element x (the
-smallest element >= x) in O(logn) time.
+Every node also stores the size of its subtree, which gives order statistics.
+This implementation supports the following operations in O(logn) time:
+ * Insert: add a new value to the set (ignoring duplicates)
+ * Erase: remove a value
+ * LowerBound: the smallest element >= x
+ * Kth: return the k-th order statistic (in 0-indexation)
+ * Rank: the number of elements < x
+ * RangeCount: the number of elements in [l, r]
+
+In-order iteration keeps the path of nodes still to be visited on a stack
+(the tree has no parent pointers, which would complicate rotations and joins):
+every node is pushed and popped once, so a step is amortized O(1) and a scan
+of m elements starting from a given value takes O(logn + m).
+
+Bulk operations are built on a single primitive, Join(L, k, R), which links
+two trees and a middle key (all of L < k < all of R): it walks down the spine
+of the taller tree until it meets a subtree of about the height of the other
+one, hangs both there under k and rebalances on the way back up. This costs
+O(|h(L) - h(R)| + 1). On top of it:
+ * Construction from a sorted array puts the middle element at the root and
+builds both halves recursively, O(n) without any rotation.
+ * Split(key) cuts the root path to key and joins the pieces on either side
+back together, O(logn) in total since the joined heights telescope.
+ * Join(other) removes the minimum of other and uses it as the middle key.
+ * Union(other) splits other by the root of this tree, unites the left and
+right parts recursively (the two recursive calls are independent, so they run
+on separate threads at the top levels) and joins the results back with the
+root, O(mlog(n/m + 1)) work for sizes m <= n.
 */
 
 #include <algorithm>
+#include <climits>
 #include <cstdint>
+#include <iterator>
+#include <optional>
 #include <string>
+#include <vector>
 
 using Long = int64_t;
 
 class AVLTree {
+  struct Node;
+
  public:
   AVLTree() : root_(nullptr) {}
+  // Values must be sorted, duplicates are skipped
+  explicit AVLTree(const std::vector<Long>& sorted);
+  AVLTree(const AVLTree&) = delete;
+  AVLTree& operator=(const AVLTree&) = delete;
+  AVLTree(AVLTree&& other) : root_(other.root_) { other.root_ = nullptr; }
+  AVLTree& operator=(AVLTree&& other);
   ~AVLTree() { RemoveNode(root_); }
 
   void Insert(Long val) { root_ = Insert(root_, val); }
+  void Erase(Long val) { root_ = Erase(root_, val); }
   Long LowerBound(Long val);
+  std::optional<Long> Kth(Long k) const;
+  Long Rank(Long val) const;
+  Long RangeCount(Long l, Long r) const;
+  Long Size() const { return Size(root_); }
+
+  // Keeps the elements < key and returns the tree of the elements >= key
+  AVLTree Split(Long key);
+  // Appends other, all its elements must be greater than the ones of this tree
+  void Join(AVLTree&& other);
+  // Moves all elements of other into this tree
+  void Union(AVLTree&& other, size_t num_threads = 1);
+
+  // Iterator, invalidated by any modification of the tree
+  class Iterator {
+    friend class AVLTree;
+
+   private:
+    std::vector<const Node*> stack_;  // top is the current node
+
+    void PushLeftPath(const Node* node);
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Long;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Long*;
+    using reference = const Long&;
+
+    Iterator() = default;
+
+    reference operator*() const { return stack_.back()->val; }
+    pointer operator->() const { return &stack_.back()->val; }
+
+    Iterator& operator++();
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return stack_.empty() ? other.stack_.empty()
+                            : !other.stack_.empty() &&
+                                  stack_.back() == other.stack_.back();
+    }
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+  };
+
+  Iterator begin() const;
+  Iterator end() const { return Iterator(); }
+  // Iterator to the smallest element >= val
+  Iterator IteratorFrom(Long val) const;
 
  private:
   struct Node {
-    Node(Long val) : left(nullptr), right(nullptr), val(val), height(1) {}
+    Node(Long val)
+        : left(nullptr), right(nullptr), val(val), height(1), size(1) {}
 
     Node* left;
     Node* right;
     Long val;
     Long height;
+    Long size;
   };
 
   Node* root_;
@@ -45,7 +138,19 @@ class AVLTree {
   static Node* RightRotation(Node* node);
   static Long CalcDisbalance(const Node* node);
   static Node* Rebalance(Node* node);
+  static Long Height(const Node* node);
+  static Long Size(const Node* node);
+  static Node* Build(const std::vector<Long>& sorted, size_t begin,
+                     size_t end);
+  static Node* Join(Node* left, Node* mid, Node* right);
+  static Node* JoinRight(Node* left, Node* mid, Node* right);
+  static Node* JoinLeft(Node* left, Node* mid, Node* right);
+  static Node* RemoveMin(Node* node, Node*& min);
+  static void Split(Node* node, Long key, Node*& left, Node*& equal,
+                    Node*& right);
+  static Node* Union(Node* first, Node* second, size_t num_threads);
   Node* Insert(Node* node, Long val);
+  static Node* Erase(Node* node, Long val);
   const Node* LowerBound(const Node* node, Long val) const;
-  void RemoveNode(Node* node);
+  static void RemoveNode(Node* node);
 };
\ No newline at end of file
@@ -1,6 +1,17 @@
 #include <gtest/gtest.h>
 #include "avl_tree.hpp"
 
+#include <set>
+
+static std::vector<Long> Elements(AVLTree& t) {
+  std::vector<Long> result;
+  for (Long x = t.LowerBound(LLONG_MIN); x != LLONG_MAX;
+       x = t.LowerBound(x + 1)) {
+    result.push_back(x);
+  }
+  return result;
+}
+
 TEST(AVLTest, InsertLowerBoundTest) {
   AVLTree t;
   t.Insert(10);
@@ -14,6 +25,182 @@ TEST(AVLTest, InsertLowerBoundTest) {
   EXPECT_EQ(t.LowerBound(-100'000), 5);
 }
 
+TEST(AVLTest, SortedConstructionTest) {
+  AVLTree t(std::vector<Long>{-5, 1, 1, 3, 8, 8, 8, 13});
+  EXPECT_EQ(Elements(t), (std::vector<Long>{-5, 1, 3, 8, 13}));
+  EXPECT_EQ(t.LowerBound(2), 3);
+  EXPECT_EQ(t.LowerBound(14), LLONG_MAX);
+
+  AVLTree empty(std::vector<Long>{});
+  EXPECT_EQ(empty.LowerBound(0), LLONG_MAX);
+}
+
+TEST(AVLTest, SplitJoinTest) {
+  std::vector<Long> values;
+  for (Long i = 0; i < 1'000; ++i) {
+    values.push_back(i * 2);
+  }
+  AVLTree t(values);
+
+  AVLTree right = t.Split(500);
+  EXPECT_EQ(t.LowerBound(499), LLONG_MAX);
+  EXPECT_EQ(right.LowerBound(0), 500);
+  EXPECT_EQ(Elements(t).size(), 250);
+  EXPECT_EQ(Elements(right).size(), 750);
+
+  AVLTree odd_split = right.Split(1'001);
+  EXPECT_EQ(Elements(right).size(), 251);
+  EXPECT_EQ(odd_split.LowerBound(0), 1'002);
+
+  right.Join(std::move(odd_split));
+  t.Join(std::move(right));
+  EXPECT_EQ(Elements(t), values);
+
+  AVLTree empty;
+  t.Join(std::move(empty));
+  empty.Join(std::move(t));
+  EXPECT_EQ(Elements(empty), values);
+  EXPECT_EQ(t.LowerBound(0), LLONG_MAX);
+}
+
+TEST(AVLTest, UnionStressTest) {
+  std::srand(std::time(nullptr));
+  for (size_t num_threads : {1, 2, 5}) {
+    std::set<Long> expected;
+    AVLTree t;
+    for (size_t round = 0; round < 20; ++round) {
+      AVLTree other;
+      size_t count = std::rand() % 500;
+      for (size_t i = 0; i < count; ++i) {
+        Long x = std::rand() % 5'000;
+        expected.insert(x);
+        other.Insert(x);
+      }
+      t.Union(std::move(other), num_threads);
+    }
+    EXPECT_EQ(Elements(t), std::vector<Long>(expected.begin(), expected.end()));
+  }
+}
+
+TEST(AVLTest, SplitStressTest) {
+  std::srand(std::time(nullptr));
+  for (size_t i = 0; i < 100; ++i) {
+    std::set<Long> expected;
+    AVLTree t;
+    for (size_t j = 0; j < 300; ++j) {
+      Long x = std::rand() % 1'000;
+      expected.insert(x);
+      t.Insert(x);
+    }
+    Long key = std::rand() % 1'100 - 50;
+    AVLTree right = t.Split(key);
+    EXPECT_EQ(Elements(t), std::vector<Long>(expected.begin(),
+                                             expected.lower_bound(key)));
+    EXPECT_EQ(Elements(right), std::vector<Long>(expected.lower_bound(key),
+                                                 expected.end()));
+    // A split tree stays balanced enough to keep accepting inserts
+    right.Insert(LLONG_MAX - 1);
+    t.Join(std::move(right));
+    expected.insert(LLONG_MAX - 1);
+    EXPECT_EQ(Elements(t), std::vector<Long>(expected.begin(), expected.end()));
+  }
+}
+
+TEST(AVLTest, OrderStatisticsTest) {
+  AVLTree t;
+  for (Long x : {50, 10, 30, 20, 40}) {
+    t.Insert(x);
+  }
+  EXPECT_EQ(t.Size(), 5);
+  EXPECT_EQ(t.Kth(0).value(), 10);
+  EXPECT_EQ(t.Kth(3).value(), 40);
+  EXPECT_FALSE(t.Kth(5).has_value());
+  EXPECT_FALSE(t.Kth(-1).has_value());
+  EXPECT_EQ(t.Rank(10), 0);
+  EXPECT_EQ(t.Rank(35), 3);
+  EXPECT_EQ(t.Rank(1'000), 5);
+  EXPECT_EQ(t.RangeCount(20, 40), 3);
+  EXPECT_EQ(t.RangeCount(21, 29), 0);
+  EXPECT_EQ(t.RangeCount(40, 20), 0);
+  EXPECT_EQ(t.RangeCount(LLONG_MIN, LLONG_MAX), 5);
+
+  t.Erase(30);
+  t.Erase(30);
+  EXPECT_EQ(t.Size(), 4);
+  EXPECT_EQ(t.Kth(2).value(), 40);
+  EXPECT_EQ(t.LowerBound(25), 40);
+}
+
+TEST(AVLTest, IteratorTest) {
+  AVLTree t;
+  EXPECT_EQ(t.begin(), t.end());
+  for (Long x : {5, 1, 4, 2, 3}) {
+    t.Insert(x);
+  }
+  EXPECT_EQ(std::vector<Long>(t.begin(), t.end()),
+            (std::vector<Long>{1, 2, 3, 4, 5}));
+  EXPECT_EQ(std::vector<Long>(t.IteratorFrom(3), t.end()),
+            (std::vector<Long>{3, 4, 5}));
+  EXPECT_EQ(*t.IteratorFrom(-10), 1);
+  EXPECT_EQ(t.IteratorFrom(6), t.end());
+
+  Long sum = 0;
+  for (Long x : t) {
+    sum += x;
+  }
+  EXPECT_EQ(sum, 15);
+}
+
+TEST(AVLTest, MixedStressTest) {
+  std::srand(std::time(nullptr));
+  std::set<Long> expected;
+  AVLTree t;
+  for (size_t i = 0; i < 100'000; ++i) {
+    Long x = std::rand() % 2'000;
+    switch (std::rand() % 5) {
+      case 0:
+        expected.insert(x);
+        t.Insert(x);
+        break;
+      case 1:
+        expected.erase(x);
+        t.Erase(x);
+        break;
+      case 2: {
+        Long k = std::rand() % (expected.size() + 1);
+        auto kth = t.Kth(k);
+        if (k == static_cast<Long>(expected.size())) {
+          EXPECT_FALSE(kth.has_value());
+        } else {
+          EXPECT_EQ(kth.value(), *std::next(expected.begin(), k));
+        }
+        break;
+      }
+      case 3: {
+        Long y = x + std::rand() % 100;
+        EXPECT_EQ(t.RangeCount(x, y),
+                  std::distance(expected.lower_bound(x),
+                                expected.upper_bound(y)));
+        break;
+      }
+      default: {
+        auto from = t.IteratorFrom(x);
+        auto it = expected.lower_bound(x);
+        for (size_t j = 0; j < 10 && it != expected.end(); ++j, ++it) {
+          ASSERT_NE(from, t.end());
+          EXPECT_EQ(*from++, *it);
+        }
+        if (it == expected.end()) {
+          EXPECT_EQ(from, t.end());
+        }
+      }
+    }
+    EXPECT_EQ(t.Size(), static_cast<Long>(expected.size()));
+  }
+  EXPECT_EQ(std::vector<Long>(t.begin(), t.end()),
+            std::vector<Long>(expected.begin(), expected.end()));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
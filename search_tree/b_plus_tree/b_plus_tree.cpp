@@ -0,0 +1,375 @@
+#include "b_plus_tree.hpp"
+
+void BPlusTree::Insert(Long val) {
+  Long split_key = 0;
+  Node* split_node = nullptr;
+  if (!Insert(root_, val, split_key, split_node)) {
+    return;
+  }
+  ++size_;
+  if (split_node != nullptr) {
+    Inner* root = new Inner();
+    root->children[0] = root_;
+    root->sizes[0] = SubtreeSize(root_);
+    InsertChild(root, 1, split_node, SubtreeSize(split_node));
+    InsertKey(root, 0, split_key);
+    root_ = root;
+  }
+}
+
+void BPlusTree::Erase(Long val) {
+  if (!Erase(root_, val)) {
+    return;
+  }
+  --size_;
+  if (!root_->is_leaf && root_->count == 0) {
+    Inner* root = static_cast<Inner*>(root_);
+    root_ = root->children[0];
+    delete root;
+  }
+}
+
+Long BPlusTree::LowerBound(Long val) const {
+  const Leaf* leaf = FindLeaf(val);
+  size_t pos = CountLess(leaf, val);
+  if (pos == leaf->count) {
+    leaf = leaf->next;
+    pos = 0;
+  }
+  return leaf == nullptr ? LLONG_MAX : leaf->keys[pos];
+}
+
+std::optional<Long> BPlusTree::Next(Long val) const {
+  const Leaf* leaf = FindLeaf(val);
+  size_t pos = CountLessEqual(leaf, val);
+  if (pos == leaf->count) {
+    leaf = leaf->next;
+    pos = 0;
+  }
+  if (leaf == nullptr) {
+    return std::nullopt;
+  }
+  return leaf->keys[pos];
+}
+
+std::optional<Long> BPlusTree::Prev(Long val) const {
+  const Leaf* leaf = FindLeaf(val);
+  size_t pos = CountLess(leaf, val);
+  if (pos == 0) {
+    // All leaves but the root one are non-empty
+    leaf = leaf->prev;
+    if (leaf == nullptr) {
+      return std::nullopt;
+    }
+    pos = leaf->count;
+  }
+  return leaf->keys[pos - 1];
+}
+
+std::optional<Long> BPlusTree::Kth(Long k) const {
+  if (k < 0 || k >= size_) {
+    return std::nullopt;
+  }
+  const Node* node = root_;
+  while (!node->is_leaf) {
+    const Inner* inner = static_cast<const Inner*>(node);
+    size_t i = 0;
+    while (k >= inner->sizes[i]) {
+      k -= inner->sizes[i];
+      ++i;
+    }
+    node = inner->children[i];
+  }
+  return node->keys[k];
+}
+
+bool BPlusTree::Exists(Long val) const {
+  const Leaf* leaf = FindLeaf(val);
+  size_t pos = CountLess(leaf, val);
+  return pos < leaf->count && leaf->keys[pos] == val;
+}
+
+// Padding keys are LLONG_MAX, never less than val
+size_t BPlusTree::CountLess(const Node* node, Long val) {
+  size_t count = 0;
+  for (size_t i = 0; i < cNodeSize; ++i) {
+    count += node->keys[i] < val;
+  }
+  return count;
+}
+
+size_t BPlusTree::CountLessEqual(const Node* node, Long val) {
+  size_t count = 0;
+  for (size_t i = 0; i < cNodeSize; ++i) {
+    count += node->keys[i] <= val;
+  }
+  return std::min<size_t>(count, node->count);
+}
+
+Long BPlusTree::SubtreeSize(const Node* node) {
+  if (node->is_leaf) {
+    return node->count;
+  }
+  const Inner* inner = static_cast<const Inner*>(node);
+  Long size = 0;
+  for (size_t i = 0; i <= inner->count; ++i) {
+    size += inner->sizes[i];
+  }
+  return size;
+}
+
+// The leaf where val is or would be inserted
+const BPlusTree::Leaf* BPlusTree::FindLeaf(Long val) const {
+  const Node* node = root_;
+  while (!node->is_leaf) {
+    const Inner* inner = static_cast<const Inner*>(node);
+    node = inner->children[CountLessEqual(inner, val)];
+  }
+  return static_cast<const Leaf*>(node);
+}
+
+void BPlusTree::InsertKey(Node* node, size_t pos, Long val) {
+  std::copy_backward(node->keys + pos, node->keys + node->count,
+                     node->keys + node->count + 1);
+  node->keys[pos] = val;
+  ++node->count;
+}
+
+void BPlusTree::EraseKey(Node* node, size_t pos) {
+  std::copy(node->keys + pos + 1, node->keys + node->count, node->keys + pos);
+  --node->count;
+  node->keys[node->count] = LLONG_MAX;
+}
+
+// Called before the matching InsertKey: the node has count + 1 children
+void BPlusTree::InsertChild(Inner* node, size_t pos, Node* child,
+                            Long size) {
+  size_t num_children = node->count + 1;
+  std::copy_backward(node->children + pos, node->children + num_children,
+                     node->children + num_children + 1);
+  std::copy_backward(node->sizes + pos, node->sizes + num_children,
+                     node->sizes + num_children + 1);
+  node->children[pos] = child;
+  node->sizes[pos] = size;
+}
+
+// Called before the matching EraseKey: the node has count + 1 children
+void BPlusTree::EraseChild(Inner* node, size_t pos) {
+  size_t num_children = node->count + 1;
+  std::copy(node->children + pos + 1, node->children + num_children,
+            node->children + pos);
+  std::copy(node->sizes + pos + 1, node->sizes + num_children,
+            node->sizes + pos);
+}
+
+// Returns whether val was inserted. If node got full, it is split and its
+// right half is returned in split_node with its separator in split_key
+bool BPlusTree::Insert(Node* node, Long val, Long& split_key,
+                       Node*& split_node) {
+  split_node = nullptr;
+  if (node->is_leaf) {
+    size_t pos = CountLess(node, val);
+    if (pos < node->count && node->keys[pos] == val) {
+      return false;
+    }
+    InsertKey(node, pos, val);
+  } else {
+    Inner* inner = static_cast<Inner*>(node);
+    size_t pos = CountLessEqual(inner, val);
+    Long child_split_key = 0;
+    Node* child_split_node = nullptr;
+    if (!Insert(inner->children[pos], val, child_split_key,
+                child_split_node)) {
+      return false;
+    }
+    ++inner->sizes[pos];
+    if (child_split_node != nullptr) {
+      inner->sizes[pos] = SubtreeSize(inner->children[pos]);
+      InsertChild(inner, pos + 1, child_split_node,
+                  SubtreeSize(child_split_node));
+      InsertKey(inner, pos, child_split_key);
+    }
+  }
+
+  if (node->count == cNodeSize) {
+    split_node = Split(node, split_key);
+  }
+  return true;
+}
+
+// Moves the upper half of a full node to a new one
+BPlusTree::Node* BPlusTree::Split(Node* node, Long& split_key) {
+  size_t half = cNodeSize / 2;
+  if (node->is_leaf) {
+    Leaf* leaf = static_cast<Leaf*>(node);
+    Leaf* right = new Leaf();
+    std::copy(leaf->keys + half, leaf->keys + cNodeSize, right->keys);
+    std::fill(leaf->keys + half, leaf->keys + cNodeSize, LLONG_MAX);
+    right->count = cNodeSize - half;
+    leaf->count = half;
+
+    right->next = leaf->next;
+    right->prev = leaf;
+    if (leaf->next != nullptr) {
+      leaf->next->prev = right;
+    }
+    leaf->next = right;
+    split_key = right->keys[0];
+    return right;
+  }
+
+  // keys[half] moves up to the parent
+  Inner* inner = static_cast<Inner*>(node);
+  Inner* right = new Inner();
+  split_key = inner->keys[half];
+  std::copy(inner->keys + half + 1, inner->keys + cNodeSize, right->keys);
+  std::copy(inner->children + half + 1, inner->children + cNodeSize + 1,
+            right->children);
+  std::copy(inner->sizes + half + 1, inner->sizes + cNodeSize + 1,
+            right->sizes);
+  std::fill(inner->keys + half, inner->keys + cNodeSize, LLONG_MAX);
+  right->count = cNodeSize - half - 1;
+  inner->count = half;
+  return right;
+}
+
+bool BPlusTree::Erase(Node* node, Long val) {
+  if (node->is_leaf) {
+    size_t pos = CountLess(node, val);
+    if (pos == node->count || node->keys[pos] != val) {
+      return false;
+    }
+    EraseKey(node, pos);
+    return true;
+  }
+
+  Inner* inner = static_cast<Inner*>(node);
+  size_t pos = CountLessEqual(inner, val);
+  if (!Erase(inner->children[pos], val)) {
+    return false;
+  }
+  --inner->sizes[pos];
+  if (inner->children[pos]->count < cMinKeys) {
+    FixUnderflow(inner, pos);
+  }
+  return true;
+}
+
+// children[pos] has too few keys: merge it with a sibling if they fit into
+// one node, otherwise take one key from the sibling
+void BPlusTree::FixUnderflow(Inner* parent, size_t pos) {
+  size_t left = pos > 0 ? pos - 1 : pos;
+  const Node* left_node = parent->children[left];
+  const Node* right_node = parent->children[left + 1];
+  size_t merged_count = left_node->count + right_node->count;
+  if (!left_node->is_leaf) {
+    ++merged_count;  // the separator goes down
+  }
+
+  if (merged_count <= cMaxKeys) {
+    if (left_node->is_leaf) {
+      MergeLeaves(parent, left);
+    } else {
+      MergeInner(parent, left);
+    }
+  } else if (left_node->count < right_node->count) {
+    MoveLeft(parent, left);
+  } else {
+    MoveRight(parent, left);
+  }
+}
+
+void BPlusTree::MergeLeaves(Inner* parent, size_t pos) {
+  Leaf* left = static_cast<Leaf*>(parent->children[pos]);
+  Leaf* right = static_cast<Leaf*>(parent->children[pos + 1]);
+  std::copy(right->keys, right->keys + right->count,
+            left->keys + left->count);
+  left->count += right->count;
+  left->next = right->next;
+  if (right->next != nullptr) {
+    right->next->prev = left;
+  }
+
+  parent->sizes[pos] += parent->sizes[pos + 1];
+  EraseChild(parent, pos + 1);
+  EraseKey(parent, pos);
+  delete right;
+}
+
+void BPlusTree::MergeInner(Inner* parent, size_t pos) {
+  Inner* left = static_cast<Inner*>(parent->children[pos]);
+  Inner* right = static_cast<Inner*>(parent->children[pos + 1]);
+  size_t offset = left->count + 1;
+  left->keys[left->count] = parent->keys[pos];
+  std::copy(right->keys, right->keys + right->count, left->keys + offset);
+  std::copy(right->children, right->children + right->count + 1,
+            left->children + offset);
+  std::copy(right->sizes, right->sizes + right->count + 1,
+            left->sizes + offset);
+  left->count += right->count + 1;
+
+  parent->sizes[pos] += parent->sizes[pos + 1];
+  EraseChild(parent, pos + 1);
+  EraseKey(parent, pos);
+  delete right;
+}
+
+// Moves the smallest element of children[pos + 1] to children[pos]
+void BPlusTree::MoveLeft(Inner* parent, size_t pos) {
+  Node* left = parent->children[pos];
+  Node* right = parent->children[pos + 1];
+  Long moved_size = 1;
+  if (left->is_leaf) {
+    InsertKey(left, left->count, right->keys[0]);
+    EraseKey(right, 0);
+    parent->keys[pos] = right->keys[0];
+  } else {
+    Inner* left_inner = static_cast<Inner*>(left);
+    Inner* right_inner = static_cast<Inner*>(right);
+    moved_size = right_inner->sizes[0];
+    InsertChild(left_inner, left->count + 1, right_inner->children[0],
+                moved_size);
+    InsertKey(left, left->count, parent->keys[pos]);
+    parent->keys[pos] = right->keys[0];
+    EraseChild(right_inner, 0);
+    EraseKey(right, 0);
+  }
+  parent->sizes[pos] += moved_size;
+  parent->sizes[pos + 1] -= moved_size;
+}
+
+// Moves the largest element of children[pos] to children[pos + 1]
+void BPlusTree::MoveRight(Inner* parent, size_t pos) {
+  Node* left = parent->children[pos];
+  Node* right = parent->children[pos + 1];
+  Long moved_size = 1;
+  if (left->is_leaf) {
+    InsertKey(right, 0, left->keys[left->count - 1]);
+    EraseKey(left, left->count - 1);
+    parent->keys[pos] = right->keys[0];
+  } else {
+    Inner* left_inner = static_cast<Inner*>(left);
+    Inner* right_inner = static_cast<Inner*>(right);
+    moved_size = left_inner->sizes[left->count];
+    InsertChild(right_inner, 0, left_inner->children[left->count],
+                moved_size);
+    InsertKey(right, 0, parent->keys[pos]);
+    parent->keys[pos] = left->keys[left->count - 1];
+    EraseChild(left_inner, left->count);
+    EraseKey(left, left->count - 1);
+  }
+  parent->sizes[pos] -= moved_size;
+  parent->sizes[pos + 1] += moved_size;
+}
+
+void BPlusTree::RemoveNode(Node* node) {
+  if (node->is_leaf) {
+    delete static_cast<Leaf*>(node);
+    return;
+  }
+  Inner* inner = static_cast<Inner*>(node);
+  for (size_t i = 0; i <= inner->count; ++i) {
+    RemoveNode(inner->children[i]);
+  }
+  delete inner;
+}
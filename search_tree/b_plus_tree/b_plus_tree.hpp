@@ -0,0 +1,113 @@
+/*
+How it works:
+A B+ tree is a search tree whose nodes hold many keys each, so a lookup
+touches about log_B(n) nodes instead of log2(n) and every node is a few
+adjacent cache lines instead of a separate allocation per key.
+- Leaves store the elements themselves, in sorted order, and are linked into
+a doubly linked list, so scans and Next/Prev continue across leaves without
+going back to the root.
+- Inner nodes store separators: keys[i] is <= all elements under
+children[i + 1] and > all elements under children[i]. They also store the
+number of elements under every child, which gives Kth in O(logn).
+
+Every node has room for cNodeSize = 32 keys (4 cache lines). Unused key slots
+hold LLONG_MAX, so a node is searched without branches by counting the keys
+less than x over the whole fixed-size array. The loop has no data dependent
+exits, so GCC vectorizes it once the target has 64-bit vector compares: at -O2
+with AVX2 (-mavx2 or -march=x86-64-v3), and at -O3 with SSE4.2. Plain x86-64
+(SSE2) has no such compare and the loop stays a scalar, still branch-free,
+count.
+
+A node may hold at most cNodeSize - 1 keys. Insertion adds the key to its leaf
+and splits the nodes that reach cNodeSize keys into halves, pushing a
+separator to the parent. Erasure removes the key from its leaf, and a node
+that drops below cMinKeys either borrows a key from its sibling or is merged
+into it, possibly removing a separator from the parent.
+
+This implementation supports the following operations in O(logn) time:
+ * Insert: add a new value to the set (ignoring duplicates)
+ * Erase: remove a value
+ * LowerBound: the smallest element >= x (LLONG_MAX if there is none)
+ * Next: find the smallest value greater than the given one
+ * Prev: find the greatest value smaller than the given one
+ * Kth: return the k-th order statistic (in 0-indexation)
+ * Exists: check whether a value is present
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <optional>
+
+using Long = int64_t;
+
+class BPlusTree {
+ public:
+  static constexpr size_t cNodeSize = 32;
+  static constexpr size_t cMaxKeys = cNodeSize - 1;
+  static constexpr size_t cMinKeys = cMaxKeys / 2;
+
+  BPlusTree() : root_(new Leaf()), size_(0) {}
+  BPlusTree(const BPlusTree&) = delete;
+  BPlusTree& operator=(const BPlusTree&) = delete;
+  ~BPlusTree() { RemoveNode(root_); }
+
+  void Insert(Long val);
+  void Erase(Long val);
+  Long LowerBound(Long val) const;
+  std::optional<Long> Next(Long val) const;
+  std::optional<Long> Prev(Long val) const;
+  std::optional<Long> Kth(Long k) const;
+  bool Exists(Long val) const;
+  Long Size() const { return size_; }
+
+ private:
+  struct alignas(64) Node {
+    Node(bool is_leaf) : count(0), is_leaf(is_leaf) {
+      std::fill(keys, keys + cNodeSize, LLONG_MAX);
+    }
+
+    Long keys[cNodeSize];
+    uint32_t count;
+    bool is_leaf;
+  };
+
+  struct Leaf : Node {
+    Leaf() : Node(true), prev(nullptr), next(nullptr) {}
+
+    Leaf* prev;
+    Leaf* next;
+  };
+
+  struct Inner : Node {
+    Inner() : Node(false) {}
+
+    Node* children[cNodeSize + 1];
+    Long sizes[cNodeSize + 1];  // number of elements under every child
+  };
+
+  Node* root_;
+  Long size_;
+
+  static size_t CountLess(const Node* node, Long val);
+  static size_t CountLessEqual(const Node* node, Long val);
+  static Long SubtreeSize(const Node* node);
+  const Leaf* FindLeaf(Long val) const;
+
+  static void InsertKey(Node* node, size_t pos, Long val);
+  static void EraseKey(Node* node, size_t pos);
+  static void InsertChild(Inner* node, size_t pos, Node* child, Long size);
+  static void EraseChild(Inner* node, size_t pos);
+
+  static bool Insert(Node* node, Long val, Long& split_key,
+                     Node*& split_node);
+  static Node* Split(Node* node, Long& split_key);
+  static bool Erase(Node* node, Long val);
+  static void FixUnderflow(Inner* parent, size_t pos);
+  static void MergeLeaves(Inner* parent, size_t pos);
+  static void MergeInner(Inner* parent, size_t pos);
+  static void MoveLeft(Inner* parent, size_t pos);
+  static void MoveRight(Inner* parent, size_t pos);
+
+  static void RemoveNode(Node* node);
+};
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "b_plus_tree.hpp"
+
+#include <set>
+
+TEST(BPlusTreeTest, InsertExistsTest) {
+  BPlusTree t;
+  t.Insert(10);
+  EXPECT_EQ(t.Exists(10), true);
+
+  t.Insert(5);
+  t.Insert(5);
+  EXPECT_EQ(t.Exists(7), false);
+  EXPECT_EQ(t.Size(), 2);
+}
+
+TEST(BPlusTreeTest, EraseTest) {
+  BPlusTree t;
+  t.Insert(10);
+  EXPECT_EQ(t.Exists(10), true);
+
+  t.Erase(10);
+  t.Erase(10);
+  EXPECT_EQ(t.Exists(10), false);
+  EXPECT_EQ(t.Size(), 0);
+}
+
+TEST(BPlusTreeTest, NextPrevLowerBoundTest) {
+  BPlusTree t;
+  t.Insert(10);
+  t.Insert(5);
+  t.Insert(7);
+
+  EXPECT_EQ(t.Next(7).value(), 10);
+  EXPECT_EQ(t.Prev(7).value(), 5);
+  EXPECT_FALSE(t.Next(10).has_value());
+  EXPECT_FALSE(t.Prev(5).has_value());
+  EXPECT_EQ(t.LowerBound(7), 7);
+  EXPECT_EQ(t.LowerBound(8), 10);
+  EXPECT_EQ(t.LowerBound(11), LLONG_MAX);
+}
+
+TEST(BPlusTreeTest, KthTest) {
+  BPlusTree t;
+  for (Long i = 999; i >= 0; --i) {
+    t.Insert(i * 3);
+  }
+  EXPECT_EQ(t.Kth(0).value(), 0);
+  EXPECT_EQ(t.Kth(500).value(), 1'500);
+  EXPECT_EQ(t.Kth(t.Size() - 1).value(), 2'997);
+  EXPECT_FALSE(t.Kth(t.Size()).has_value());
+}
+
+TEST(BPlusTreeTest, ExtremeValuesTest) {
+  BPlusTree t;
+  t.Insert(LLONG_MAX);
+  t.Insert(LLONG_MIN);
+  for (Long i = 0; i < 100; ++i) {
+    t.Insert(i);
+  }
+  EXPECT_EQ(t.Exists(LLONG_MAX), true);
+  EXPECT_EQ(t.Next(99).value(), LLONG_MAX);
+  EXPECT_EQ(t.Prev(LLONG_MAX).value(), 99);
+  EXPECT_FALSE(t.Next(LLONG_MAX).has_value());
+  EXPECT_EQ(t.Kth(t.Size() - 1).value(), LLONG_MAX);
+  EXPECT_EQ(t.Kth(0).value(), LLONG_MIN);
+}
+
+TEST(BPlusTreeTest, StressTest) {
+  std::srand(std::time(nullptr));
+  for (Long range : {100, 10'000}) {
+    std::set<Long> expected;
+    BPlusTree t;
+    for (size_t i = 0; i < 200'000; ++i) {
+      Long x = std::rand() % range;
+      switch (std::rand() % 6) {
+        case 0:
+        case 1:
+          expected.insert(x);
+          t.Insert(x);
+          break;
+        case 2:
+          expected.erase(x);
+          t.Erase(x);
+          break;
+        case 3: {
+          auto it = expected.upper_bound(x);
+          auto next = t.Next(x);
+          EXPECT_EQ(next.has_value(), it != expected.end());
+          if (next.has_value() && it != expected.end()) {
+            EXPECT_EQ(next.value(), *it);
+          }
+          auto prev = t.Prev(x);
+          it = expected.lower_bound(x);
+          EXPECT_EQ(prev.has_value(), it != expected.begin());
+          if (prev.has_value() && it != expected.begin()) {
+            EXPECT_EQ(prev.value(), *std::prev(it));
+          }
+          break;
+        }
+        case 4: {
+          auto it = expected.lower_bound(x);
+          EXPECT_EQ(t.LowerBound(x), it == expected.end() ? LLONG_MAX : *it);
+          EXPECT_EQ(t.Exists(x), expected.count(x) == 1);
+          break;
+        }
+        default: {
+          if (expected.empty()) {
+            break;
+          }
+          Long k = std::rand() % expected.size();
+          EXPECT_EQ(t.Kth(k).value(), *std::next(expected.begin(), k));
+        }
+      }
+      EXPECT_EQ(t.Size(), static_cast<Long>(expected.size()));
+    }
+
+    for (Long x = 0; x < range; ++x) {
+      t.Erase(x);
+    }
+    EXPECT_EQ(t.Size(), 0);
+    EXPECT_EQ(t.LowerBound(LLONG_MIN), LLONG_MAX);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
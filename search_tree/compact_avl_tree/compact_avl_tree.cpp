@@ -0,0 +1,93 @@
+#include "compact_avl_tree.hpp"
+
+Long CompactAVLTree::LowerBound(Long val) const {
+  Long result = LLONG_MAX;
+  Index node = root_;
+  while (node != cNull) {
+    if (pool_[node].val >= val) {
+      result = pool_[node].val;
+      node = pool_[node].left;
+    } else {
+      node = pool_[node].right;
+    }
+  }
+  return result;
+}
+
+void CompactAVLTree::Clear() {
+  std::vector<Node>(1).swap(pool_);
+  std::vector<uint8_t>(1, 0).swap(heights_);
+  root_ = cNull;
+}
+
+void CompactAVLTree::UpdateHeight(Index node) {
+  heights_[node] =
+      std::max(heights_[pool_[node].left], heights_[pool_[node].right]) + 1;
+}
+
+CompactAVLTree::Index CompactAVLTree::LeftRotation(Index node) {
+  Index child = pool_[node].right;
+  if (child == cNull) {
+    return node;
+  }
+  pool_[node].right = pool_[child].left;
+  pool_[child].left = node;
+  UpdateHeight(node);
+  UpdateHeight(child);
+  return child;
+}
+
+CompactAVLTree::Index CompactAVLTree::RightRotation(Index node) {
+  Index child = pool_[node].left;
+  if (child == cNull) {
+    return node;
+  }
+  pool_[node].left = pool_[child].right;
+  pool_[child].right = node;
+  UpdateHeight(node);
+  UpdateHeight(child);
+  return child;
+}
+
+int CompactAVLTree::CalcDisbalance(Index node) const {
+  return static_cast<int>(heights_[pool_[node].right]) -
+         heights_[pool_[node].left];
+}
+
+CompactAVLTree::Index CompactAVLTree::Rebalance(Index node) {
+  UpdateHeight(node);
+  int disb = CalcDisbalance(node);
+  if (disb == 2) {
+    if (CalcDisbalance(pool_[node].right) < 0) {
+      pool_[node].right = RightRotation(pool_[node].right);
+    }
+    return LeftRotation(node);
+  }
+  if (disb == -2) {
+    if (CalcDisbalance(pool_[node].left) > 0) {
+      pool_[node].left = LeftRotation(pool_[node].left);
+    }
+    return RightRotation(node);
+  }
+  return node;
+}
+
+CompactAVLTree::Index CompactAVLTree::Insert(Index node, Long val) {
+  if (node == cNull) {
+    pool_.push_back({val, cNull, cNull});
+    heights_.push_back(1);
+    return pool_.size() - 1;
+  }
+  if (val == pool_[node].val) {
+    return node;
+  }
+  // The recursive call may grow the pool, so no references are kept across it
+  if (val < pool_[node].val) {
+    Index child = Insert(pool_[node].left, val);
+    pool_[node].left = child;
+  } else {
+    Index child = Insert(pool_[node].right, val);
+    pool_[node].right = child;
+  }
+  return Rebalance(node);
+}
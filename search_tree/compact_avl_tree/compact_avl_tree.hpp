@@ -0,0 +1,56 @@
+/*
+How it works:
+The same AVL tree as AVLTree (see avl_tree.hpp), with a different memory
+layout. Instead of allocating every node with new, the nodes live in one
+contiguous pool and refer to their children by 32-bit indices into it. A node
+then takes 16 bytes (the value and two indices) instead of 32, and the height,
+which never exceeds ~45, is kept in a separate byte array. That is 17 bytes
+per key, and the nodes allocated one after another stay close in memory.
+
+Index 0 is a sentinel standing for an empty subtree: its height is 0, so
+heights can be read without null checks.
+
+Since the nodes own no resources, dropping the whole tree is releasing the
+pool, no recursive traversal is needed.
+
+It supports inserting elements and getting lower bound of an element x (the
+smallest element >= x) in O(logn) time.
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+using Long = int64_t;
+
+class CompactAVLTree {
+ public:
+  CompactAVLTree() : pool_(1), heights_(1, 0) {}
+
+  void Insert(Long val) { root_ = Insert(root_, val); }
+  Long LowerBound(Long val) const;
+  size_t Size() const { return pool_.size() - 1; }
+  void Clear();
+
+ private:
+  using Index = uint32_t;
+  static constexpr Index cNull = 0;
+
+  struct Node {
+    Long val;
+    Index left;
+    Index right;
+  };
+
+  std::vector<Node> pool_;
+  std::vector<uint8_t> heights_;
+  Index root_ = cNull;
+
+  void UpdateHeight(Index node);
+  Index LeftRotation(Index node);
+  Index RightRotation(Index node);
+  int CalcDisbalance(Index node) const;
+  Index Rebalance(Index node);
+  Index Insert(Index node, Long val);
+};
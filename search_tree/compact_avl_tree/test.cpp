@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "compact_avl_tree.hpp"
+
+#include <set>
+
+TEST(CompactAVLTest, InsertLowerBoundTest) {
+  CompactAVLTree t;
+  t.Insert(10);
+  EXPECT_EQ(t.LowerBound(10), 10);
+
+  t.Insert(5);
+  EXPECT_EQ(t.LowerBound(7), 10);
+
+  t.Insert(15);
+  t.Insert(15);
+  EXPECT_EQ(t.LowerBound(12), 15);
+  EXPECT_EQ(t.LowerBound(-100'000), 5);
+  EXPECT_EQ(t.LowerBound(16), LLONG_MAX);
+  EXPECT_EQ(t.Size(), 3);
+
+  t.Clear();
+  EXPECT_EQ(t.Size(), 0);
+  EXPECT_EQ(t.LowerBound(-100'000), LLONG_MAX);
+  t.Insert(1);
+  EXPECT_EQ(t.LowerBound(-100'000), 1);
+}
+
+TEST(CompactAVLTest, StressTest) {
+  std::srand(std::time(nullptr));
+  std::set<Long> expected;
+  CompactAVLTree t;
+  for (size_t i = 0; i < 100'000; ++i) {
+    Long x = std::rand() % 200'000 - 100'000;
+    if (std::rand() % 2 == 0) {
+      expected.insert(x);
+      t.Insert(x);
+    } else {
+      auto it = expected.lower_bound(x);
+      EXPECT_EQ(t.LowerBound(x), it == expected.end() ? LLONG_MAX : *it);
+    }
+  }
+  EXPECT_EQ(t.Size(), expected.size());
+}
+
+TEST(CompactAVLTest, SortedInsertTest) {
+  CompactAVLTree t;
+  for (Long i = 0; i < 1'000'000; ++i) {
+    t.Insert(i);
+  }
+  for (Long i = 0; i < 1'000'000; i += 997) {
+    EXPECT_EQ(t.LowerBound(i), i);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
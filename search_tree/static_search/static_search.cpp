@@ -0,0 +1,88 @@
+#include "static_search.hpp"
+
+#include <algorithm>
+
+EytzingerSearch::EytzingerSearch(const std::vector<Long>& sorted)
+    : size_(sorted.size()), lines_(size_ / cKeysPerLine + 1) {
+  size_t pos = 0;
+  Build(sorted, pos, 1);
+}
+
+// In-order traversal of the implicit tree assigns the sorted keys
+void EytzingerSearch::Build(const std::vector<Long>& sorted, size_t& pos,
+                            size_t k) {
+  if (k > size_) {
+    return;
+  }
+  Build(sorted, pos, 2 * k);
+  Key(k) = sorted[pos++];
+  Build(sorted, pos, 2 * k + 1);
+}
+
+Long EytzingerSearch::LowerBound(Long val) const {
+  size_t k = 1;
+  while (k <= size_) {
+    __builtin_prefetch(&Key(std::min(k << cPrefetchLevels, size_)));
+    k = 2 * k + (Key(k) < val);
+  }
+  // Every 1 at the end of k is a right turn, the 0 before them the last left
+  k >>= __builtin_ctzll(~k) + 1;
+  return k == 0 ? LLONG_MAX : Key(k);
+}
+
+SPlusTree::SPlusTree(const std::vector<Long>& sorted) : size_(sorted.size()) {
+  // Every layer has one key per block of the layer below, except the last
+  // block of each group of cBlockSize + 1. An empty tree still has one block
+  std::vector<size_t> layer_sizes{
+      std::max<size_t>((size_ + cBlockSize - 1) / cBlockSize, 1)};
+  while (layer_sizes.back() > 1) {
+    layer_sizes.push_back((layer_sizes.back() + cBlockSize) /
+                          (cBlockSize + 1));
+  }
+  size_t total_blocks = 0;
+  for (size_t layer_size : layer_sizes) {
+    layer_offsets_.push_back(total_blocks);
+    total_blocks += layer_size;
+  }
+
+  blocks_.resize(total_blocks);
+  for (size_t i = 0; i < layer_sizes[0] * cBlockSize; ++i) {
+    blocks_[i / cBlockSize].keys[i % cBlockSize] =
+        i < size_ ? sorted[i] : LLONG_MAX;
+  }
+
+  // Key j of block b is the smallest key under its child j + 1: the first
+  // key of the leftmost bottom block of that subtree
+  size_t subtree_blocks = 1;  // bottom blocks under a block of the layer below
+  for (size_t h = 1; h < layer_sizes.size(); ++h) {
+    for (size_t b = 0; b < layer_sizes[h]; ++b) {
+      Block& block = blocks_[layer_offsets_[h] + b];
+      for (size_t j = 0; j < cBlockSize; ++j) {
+        size_t bottom_pos =
+            (b * (cBlockSize + 1) + j + 1) * subtree_blocks * cBlockSize;
+        block.keys[j] = bottom_pos < size_ ? sorted[bottom_pos] : LLONG_MAX;
+      }
+    }
+    subtree_blocks *= cBlockSize + 1;
+  }
+}
+
+size_t SPlusTree::Rank(const Block& block, Long val) {
+  size_t count = 0;
+  for (size_t i = 0; i < cBlockSize; ++i) {
+    count += block.keys[i] < val;
+  }
+  return count;
+}
+
+Long SPlusTree::LowerBound(Long val) const {
+  size_t k = 0;
+  for (size_t h = layer_offsets_.size() - 1; h > 0; --h) {
+    k = k * (cBlockSize + 1) + Rank(blocks_[layer_offsets_[h] + k], val);
+  }
+  // The bottom layer is the sorted array: a lower bound past the end of the
+  // block is the first key of the next one
+  size_t pos = k * cBlockSize + Rank(blocks_[k], val);
+  return pos < size_ ? blocks_[pos / cBlockSize].keys[pos % cBlockSize]
+                     : LLONG_MAX;
+}
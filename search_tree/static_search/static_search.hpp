@@ -0,0 +1,89 @@
+/*
+How it works:
+Two read-only alternatives to AVLTree::LowerBound for sets that are built once
+from a sorted array and then only queried. Both keep the keys in one array in
+an order that makes the search touch few cache lines, and both search without
+branches, so there is nothing for the branch predictor to mispredict.
+
+EytzingerSearch stores the keys in BFS order of an implicit complete binary
+search tree: the root is at index 1, and the children of k are 2k and 2k + 1.
+The search goes k -> 2k + (tree[k] < x) until it falls off the tree, and the
+lower bound is then the last node where it went left, found by stripping the
+trailing ones (plus one more bit) of k. The keys are stored in 64-byte aligned
+cache lines of 8, so the descendants of k three levels down, 8k ... 8k + 7,
+fill exactly one line. Prefetching it while the current level is compared
+hides most of the memory latency. Near the bottom of the tree the prefetch
+address is clamped to the last key, so it always stays inside the array.
+
+SPlusTree is a static B+ tree with blocks of cBlockSize = 16 keys, aligned to
+cache lines, and no pointers: the children of block k of a layer are blocks
+k * 17 ... k * 17 + 16 of the layer below. The bottom layer is the sorted
+array itself, and key j of an upper block is the smallest key of its child
+j + 1. At each layer the child is the number of keys < x in the block, which
+is counted over the whole block without branches. GCC vectorizes the count at
+-O2 with AVX2 and at -O3 with SSE4.2; the default SSE2 target has no 64-bit
+vector compare. This takes log_17(n) steps, each touching two cache lines.
+
+Time Complexity: O(n) build + O(logn) for each query
+Memory Complexity: O(n)
+*/
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using Long = int64_t;
+
+class EytzingerSearch {
+ public:
+  // Values must be sorted
+  EytzingerSearch(const std::vector<Long>& sorted);
+
+  // The smallest element >= val, LLONG_MAX if there is none
+  Long LowerBound(Long val) const;
+  size_t Size() const { return size_; }
+
+ private:
+  static constexpr size_t cPrefetchLevels = 3;
+  static constexpr size_t cKeysPerLine = size_t{1} << cPrefetchLevels;
+
+  struct alignas(64) Line {
+    Long keys[cKeysPerLine];
+  };
+
+  size_t size_;
+  std::vector<Line> lines_;  // keys 1...size_, key 0 is unused
+
+  Long& Key(size_t k) {
+    return lines_[k / cKeysPerLine].keys[k % cKeysPerLine];
+  }
+  const Long& Key(size_t k) const {
+    return lines_[k / cKeysPerLine].keys[k % cKeysPerLine];
+  }
+
+  void Build(const std::vector<Long>& sorted, size_t& pos, size_t k);
+};
+
+class SPlusTree {
+ public:
+  static constexpr size_t cBlockSize = 16;
+
+  // Values must be sorted
+  SPlusTree(const std::vector<Long>& sorted);
+
+  // The smallest element >= val, LLONG_MAX if there is none
+  Long LowerBound(Long val) const;
+  size_t Size() const { return size_; }
+
+ private:
+  struct alignas(64) Block {
+    Long keys[cBlockSize];
+  };
+
+  size_t size_;
+  std::vector<Block> blocks_;          // all layers, the bottom one first
+  std::vector<size_t> layer_offsets_;  // first block of every layer
+
+  static size_t Rank(const Block& block, Long val);
+};
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "static_search.hpp"
+
+#include <algorithm>
+
+static Long ExpectedLowerBound(const std::vector<Long>& sorted, Long val) {
+  auto it = std::lower_bound(sorted.begin(), sorted.end(), val);
+  return it == sorted.end() ? LLONG_MAX : *it;
+}
+
+TEST(StaticSearchTest, LowerBoundTest) {
+  std::vector<Long> sorted{-7, 0, 3, 3, 10, 42};
+  EytzingerSearch eytzinger(sorted);
+  SPlusTree s_plus_tree(sorted);
+  for (Long val : {-100, -7, -6, 0, 2, 3, 4, 10, 42, 43}) {
+    EXPECT_EQ(eytzinger.LowerBound(val), ExpectedLowerBound(sorted, val));
+    EXPECT_EQ(s_plus_tree.LowerBound(val), ExpectedLowerBound(sorted, val));
+  }
+  EXPECT_EQ(eytzinger.Size(), 6);
+  EXPECT_EQ(s_plus_tree.Size(), 6);
+}
+
+TEST(StaticSearchTest, EmptyTest) {
+  EytzingerSearch eytzinger({});
+  SPlusTree s_plus_tree({});
+  EXPECT_EQ(eytzinger.LowerBound(0), LLONG_MAX);
+  EXPECT_EQ(s_plus_tree.LowerBound(0), LLONG_MAX);
+}
+
+TEST(StaticSearchTest, StressTest) {
+  std::srand(std::time(nullptr));
+  // Sizes around block and layer boundaries of SPlusTree
+  for (size_t n : {1, 15, 16, 17, 272, 273, 289, 290, 4'913, 5'000, 100'000}) {
+    for (Long mod : {4, 1'000'000}) {
+      std::vector<Long> sorted(n);
+      for (auto& elem : sorted) {
+        elem = std::rand() % mod;
+      }
+      std::sort(sorted.begin(), sorted.end());
+      EytzingerSearch eytzinger(sorted);
+      SPlusTree s_plus_tree(sorted);
+
+      for (size_t i = 0; i < 2'000; ++i) {
+        Long val = std::rand() % (mod + 2) - 1;
+        EXPECT_EQ(eytzinger.LowerBound(val), ExpectedLowerBound(sorted, val));
+        EXPECT_EQ(s_plus_tree.LowerBound(val),
+                  ExpectedLowerBound(sorted, val));
+      }
+      EXPECT_EQ(eytzinger.LowerBound(LLONG_MIN), sorted[0]);
+      EXPECT_EQ(s_plus_tree.LowerBound(LLONG_MIN), sorted[0]);
+      EXPECT_EQ(eytzinger.LowerBound(LLONG_MAX), LLONG_MAX);
+      EXPECT_EQ(s_plus_tree.LowerBound(LLONG_MAX), LLONG_MAX);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}